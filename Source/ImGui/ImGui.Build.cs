@@ -24,6 +24,10 @@ public class ImGui : ModuleRules
 		// Enable runtime loader, if you want this module to be automatically loaded in runtime builds (monolithic).
 		bool bEnableRuntimeLoader = true;
 
+		// Compile ImGui with 32-bit draw indices. Index data can be then copied to Slate without conversion (requires
+		// 32-bit SlateIndex, which is the default on all platforms supported by the engine).
+		bool bUse32BitDrawIndices = false;
+
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 #if UE_4_24_OR_LATER
@@ -64,6 +68,7 @@ public class ImGui : ModuleRules
 				"EnhancedInput",
 				"Engine",
 				"InputCore",
+				"Json",
 				"Sockets",
 				"Slate",
 				"SlateCore",
@@ -75,6 +80,7 @@ public class ImGui : ModuleRules
 		PublicDefinitions.Add("NETIMGUI_POSIX_SOCKETS_ENABLED=0");
 		PublicDefinitions.Add("NETIMGUI_WINSOCKET_ENABLED=0");
 		PublicDefinitions.Add("JSON_NOEXCEPTION");
+		PublicDefinitions.Add(string.Format("IMGUI_USE_32BIT_DRAW_INDICES={0}", bUse32BitDrawIndices ? 1 : 0));
 
 		if (bBuildEditor)
 		{
@@ -131,7 +131,7 @@ void FImGuiContextManager::OnWorldTickStart(UWorld* World, ELevelTick TickType,
 		FImGuiContextProxy& ContextProxy = GetWorldContextProxy(*World);
 
 		// Set as current, so we have right context ready when updating world objects.
-		ContextProxy.SetAsCurrent();
+		ContextProxy.SetAsCurrentForWorldTick();
 
 		// Only game/PIE worlds should try to use netimgui
 		if (World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE)
@@ -314,4 +314,18 @@ void FImGuiContextManager::RebuildFontAtlas()
 	}
 
 	BuildFontAtlas(FImGuiModule::Get().GetProperties().GetCustomFonts());
+
+	// Idle contexts need to be updated to use the new font atlas before old resources are released.
+	RequestRedraw();
+}
+
+void FImGuiContextManager::RequestRedraw()
+{
+	for (auto& Pair : Contexts)
+	{
+		if (Pair.Value.ContextProxy)
+		{
+			Pair.Value.ContextProxy->RequestRedraw();
+		}
+	}
 }
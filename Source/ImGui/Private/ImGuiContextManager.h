@@ -38,6 +38,8 @@ public:
 
 	FImGuiNetControl& GetNetControl() { return NetControl; }
 
+	const FImGuiModuleSettings& GetSettings() const { return Settings; }
+
 #if WITH_EDITOR
 	// Get or create editor ImGui context proxy.
 	FORCEINLINE FImGuiContextProxy& GetEditorContextProxy() { return *GetEditorContextData().ContextProxy; }
@@ -71,6 +73,9 @@ public:
 
 	void RebuildFontAtlas();
 
+	// Request all contexts to be updated in the next tick, even if they are idle.
+	void RequestRedraw();
+
 private:
 
 	struct FContextData
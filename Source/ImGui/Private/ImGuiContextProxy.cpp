@@ -5,19 +5,51 @@
 #include "ImGuiDelegatesContainer.h"
 #include "ImGuiImplementation.h"
 #include "ImGuiInteroperability.h"
+#include "ImGuiModuleDebug.h"
 #include "Utilities/Arrays.h"
 #include "VersionCompatibility.h"
 #include "ImGuiModule.h"
 #include "ImGuiModuleProperties.h"
+#include "ImGuiModuleSettings.h"
 #include "ImGuiContextManager.h"
 
+#include <Async/ParallelFor.h>
 #include <GenericPlatform/GenericPlatformFile.h>
+#include <HAL/IConsoleManager.h>
+#include <Misc/ScopeLock.h>
 #include <Misc/Paths.h>
 
 
 static constexpr float DEFAULT_CANVAS_WIDTH = 3840.f;
 static constexpr float DEFAULT_CANVAS_HEIGHT = 2160.f;
 
+// Number of frames updated after the last activity, before context can be considered idle. ImGui may need a few
+// frames to settle after input (e.g. to update hovered items or auto-resize windows).
+static constexpr int32 ACTIVE_FRAMES_AFTER_INPUT = 3;
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Slate Draw Lists Reused"), STAT_ImGuiSlateDrawListsReused, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Slate Draw Lists Converted"), STAT_ImGuiSlateDrawListsConverted, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Throttled Frames Skipped"), STAT_ImGuiThrottledFramesSkipped, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Idle Frames Skipped"), STAT_ImGuiIdleFramesSkipped, STATGROUP_ImGui);
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> ParallelDrawConversion(TEXT("ImGui.ParallelDrawConversion"), 0,
+		TEXT("Convert ImGui draw lists for Slate on worker threads, right after the end of each ImGui frame.\n")
+		TEXT("0: disabled (default), draw lists are converted on the game thread during paint\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> MaxUpdateRate(TEXT("ImGui.MaxUpdateRate"), -1.f,
+		TEXT("Maximum rate in Hz at which ImGui contexts are updated. Skipped frames are not started, module delegates are not\n")
+		TEXT("called, input accumulates until the next update and contexts present the last draw data. Widgets drawn outside\n")
+		TEXT("of module delegates in skipped frames are discarded. Contexts with active items or input are not throttled.\n")
+		TEXT("<0: use rates from module properties (default)\n")
+		TEXT("0: update contexts in every frame\n")
+		TEXT(">0: maximum update rate for all contexts"),
+		ECVF_Default);
+}
+
 
 namespace
 {
@@ -107,6 +139,9 @@ FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextInd
 	// Set the initial DPI scale.
 	SetDPIScale(InDPIScale);
 
+	// With 16-bit indices, ImGui can split large draw lists using vertex offsets, which we handle when converting data.
+	IO.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
 	// Initialize key mapping, so context can correctly interpret input state.
 	ImGuiInterops::SetUnrealKeyMap(IO);
 
@@ -119,6 +154,8 @@ FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextInd
 
 FImGuiContextProxy::~FImGuiContextProxy()
 {
+	WaitForSlateDrawData();
+
 	if (Context)
 	{
 		// It seems that to properly shutdown context we need to set it as the current one (at least in this framework
@@ -128,6 +165,11 @@ FImGuiContextProxy::~FImGuiContextProxy()
 		// Save context data and destroy.
 		ImGui::DestroyContext(Context);
 	}
+
+	if (DiscardContext)
+	{
+		ImGui::DestroyContext(DiscardContext);
+	}
 }
 
 void FImGuiContextProxy::ResetDisplaySize()
@@ -154,6 +196,8 @@ void FImGuiContextProxy::SetDPIScale(float Scale)
 		FGuardCurrentContext GuardContext;
 		SetAsCurrent();
 		ImGui::GetStyle() = MoveTemp(NewStyle);
+
+		RequestRedraw();
 	}
 }
 
@@ -197,13 +241,17 @@ void FImGuiContextProxy::Tick(float DeltaSeconds, FImGuiContextManager& ContextM
 
 		SetAsCurrent();
 
+		// Time is accumulated across skipped frames, so ImGui can advance its state correctly in the next update.
+		AccumulatedDeltaSeconds += DeltaSeconds;
+		SecondsSinceUpdate += DeltaSeconds;
+
 		if (bIsFrameStarted)
 		{
 			// Make sure that draw events are called before the end of the frame.
 			DrawDebug();
 
-			// Ending frame will produce render output that we capture and store for later use. This also puts context to
-			// state in which it does not allow to draw controls, so we want to immediately start a new frame.
+			// Ending frame will produce render output that we capture and store for later use. This also puts context
+			// to state in which it does not allow to draw controls.
 			EndFrame(ContextManager);
 		}
 
@@ -213,14 +261,94 @@ void FImGuiContextProxy::Tick(float DeltaSeconds, FImGuiContextManager& ContextM
 		bHasHoveredAnyWindow = ImGui::IsWindowHovered(ImGuiHoveredFlags_AnyWindow);
 		MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
 
+		if (IsThrottled(DeltaSeconds))
+		{
+			// If throttled, don't start the next frame, so the context keeps its state (including active items) and
+			// input accumulates until the next update, while we keep presenting the last draw data.
+			INC_DWORD_STAT(STAT_ImGuiThrottledFramesSkipped);
+			BeginDiscardFrame(DeltaSeconds);
+			return;
+		}
+
+		if (CanSkipFrame(ContextManager))
+		{
+			// If idle, skip the next frame in the same way as when throttled.
+			INC_DWORD_STAT(STAT_ImGuiIdleFramesSkipped);
+			BeginDiscardFrame(DeltaSeconds);
+			return;
+		}
+
+		// Clear before drawing, so listeners can request a redraw for the next frame.
+		bIsRedrawRequested = false;
+		SecondsSinceUpdate = 0.f;
+
+		EndDiscardFrame();
+		SetAsCurrent();
+
 		// Begin a new frame and set the context back to a state in which it allows to draw controls.
-		BeginFrame(&ContextManager, DeltaSeconds);
+		BeginFrame(&ContextManager, AccumulatedDeltaSeconds);
+		AccumulatedDeltaSeconds = 0.f;
 
 		// Update remaining context information.
 		bWantsMouseCapture = ImGui::GetIO().WantCaptureMouse;
 	}
 }
 
+bool FImGuiContextProxy::IsThrottled(float DeltaSeconds) const
+{
+	// Don't delay key and button state changes, so short presses are not lost between updates.
+	if (!InputState.GetKeysUpdateRange().IsEmpty() || !InputState.GetMouseButtonsUpdateRange().IsEmpty())
+	{
+		return false;
+	}
+
+	// Don't throttle interactions (e.g. dragging or text editing) and input that would be delayed or lost.
+	const ImGuiIO& IO = ImGui::GetIO();
+	if (bHasActiveItem || IO.WantCaptureMouse || IO.WantTextInput || InputState.GetMouseWheelDelta() != 0.f
+		|| InputState.GetCharacters().Num() > 0)
+	{
+		return false;
+	}
+
+	float MaxUpdateRate = CVars::MaxUpdateRate.GetValueOnGameThread();
+	if (MaxUpdateRate < 0.f)
+	{
+		MaxUpdateRate = FImGuiModule::Get().GetProperties().GetContextMaxUpdateRate(Name);
+	}
+
+	// Update in the frame that is closer to the target time, so on average we match the requested rate.
+	return MaxUpdateRate > 0.f && SecondsSinceUpdate + DeltaSeconds * 0.5f < 1.f / MaxUpdateRate;
+}
+
+bool FImGuiContextProxy::CanSkipFrame(FImGuiContextManager& ContextManager)
+{
+	const FImGuiModuleSettings& Settings = ContextManager.GetSettings();
+	if (!Settings.IsIdleFrameSkippingEnabled())
+	{
+		return false;
+	}
+
+	const ImGuiIO& IO = ImGui::GetIO();
+	const bool bIsActive = bIsRedrawRequested || bHasActiveItem || InputState.HasUpdates()
+		|| IO.DisplaySize.x != (float)DisplaySize.X || IO.DisplaySize.y != (float)DisplaySize.Y
+		|| ContextManager.GetNetControl().IsConnected(ContextIndex);
+
+	if (bIsActive)
+	{
+		NumActiveFramesLeft = ACTIVE_FRAMES_AFTER_INPUT;
+		return false;
+	}
+
+	if (NumActiveFramesLeft > 0)
+	{
+		NumActiveFramesLeft--;
+		return false;
+	}
+
+	// Make sure that idle context is updated from time to time, so its content doesn't get too stale.
+	return SecondsSinceUpdate < Settings.GetMaxIdleInterval();
+}
+
 void FImGuiContextProxy::BeginFrame(FImGuiContextManager* ContextManager, float DeltaTime)
 {
 	if (!bIsFrameStarted)
@@ -247,6 +375,48 @@ void FImGuiContextProxy::BeginFrame(FImGuiContextManager* ContextManager, float
 	}
 }
 
+void FImGuiContextProxy::BeginDiscardFrame(float DeltaTime)
+{
+	// Expects this context to be current.
+	ImFontAtlas* FontAtlas = ImGui::GetIO().Fonts;
+	const ImVec2 ContextDisplaySize = ImGui::GetIO().DisplaySize;
+
+	// Leave the discard context as the current one, so calls made before the next tick don't reach this context.
+	if (DiscardContext)
+	{
+		ImGui::SetCurrentContext(DiscardContext);
+	}
+	else
+	{
+		// Sharing font atlas allows to use the same fonts as in this context. Discarded frames are never saved.
+		DiscardContext = ImGui::CreateContext(FontAtlas);
+		ImGui::SetCurrentContext(DiscardContext);
+		ImGui::GetIO().IniFilename = nullptr;
+	}
+
+	if (bIsDiscardFrameStarted)
+	{
+		ImGui::EndFrame();
+	}
+
+	ImGuiIO& IO = ImGui::GetIO();
+	IO.DeltaTime = DeltaTime;
+	IO.DisplaySize = ContextDisplaySize;
+
+	ImGui::NewFrame();
+	bIsDiscardFrameStarted = true;
+}
+
+void FImGuiContextProxy::EndDiscardFrame()
+{
+	if (bIsDiscardFrameStarted)
+	{
+		ImGui::SetCurrentContext(DiscardContext);
+		ImGui::EndFrame();
+		bIsDiscardFrameStarted = false;
+	}
+}
+
 void FImGuiContextProxy::EndFrame(FImGuiContextManager& ContextManager)
 {
 	if (bIsFrameStarted)
@@ -260,34 +430,151 @@ void FImGuiContextProxy::EndFrame(FImGuiContextManager& ContextManager)
 		ImGui::Render();
 
 		// Update our draw data, so we can use them later during Slate rendering while ImGui is in the middle of the
-		// next frame.
-		DrawLists.SetNum(0, EAllowShrinking::No);
+		// next frame. We write to a frame not referenced by consumers and publish it when complete. Draw lists left in
+		// that frame from older updates are swapped back to ImGui, so it can reuse their allocations.
+		const TSharedRef<FImGuiFrameDrawData, ESPMode::ThreadSafe> FrameRef = AcquireFrameDrawData();
+		FImGuiFrameDrawData& Frame = *FrameRef;
+		int32 NumDrawLists = 0;
+
+		// Net data are drawn under the local imgui. They are immutable snapshots shared with the net control, so we only
+		// keep a reference, which costs nothing if no new remote frame arrived.
+		Frame.RemoteDrawData = ContextManager.GetNetControl().GetServerDrawData(ContextIndex);
+
+		UpdateDrawData(ImGui::GetDrawData(), Frame.DrawLists, NumDrawLists);
+
+		Frame.DrawLists.SetNum(NumDrawLists, EAllowShrinking::No);
+		Frame.FrameId = ++LastFrameId;
 
-		// Put net data in first so it will be drawn under the local imgui
-		if (TUniquePtr<ImDrawData> NetDrawData = ContextManager.GetNetControl().GetServerDrawData(ContextIndex))
 		{
-			UpdateDrawData(NetDrawData.Get());
+			FScopeLock Lock(&PublishedFrameDrawDataLock);
+			PublishedFrameDrawData = FrameRef;
 		}
 
-		UpdateDrawData(ImGui::GetDrawData());
+		// Start converting new data for Slate, assuming that they will be drawn with the same parameters as before.
+		// Conversion reads published data, so we only need to wait for the previous one to finish.
+		WaitForSlateDrawData();
+		if (bHasSlateConversionParams && CVars::ParallelDrawConversion.GetValueOnGameThread() > 0)
+		{
+			SlateConversionTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]()
+			{
+				ConvertSlateDrawData(SlateTransform, SlateClippingRect, true);
+			});
+		}
 
 		bIsFrameStarted = false;
 	}
 }
 
-void FImGuiContextProxy::UpdateDrawData(ImDrawData* DrawData)
+void FImGuiContextProxy::UpdateDrawData(ImDrawData* DrawData, TArray<FImGuiDrawList>& OutDrawLists, int32& NumDrawLists)
 {
 	if (DrawData && DrawData->CmdListsCount > 0)
 	{
-		const int StartIndex = DrawLists.Num();
+		const int StartIndex = NumDrawLists;
 
-		DrawLists.SetNum(DrawLists.Num() + DrawData->CmdListsCount, EAllowShrinking::No);
+		NumDrawLists += DrawData->CmdListsCount;
+		if (OutDrawLists.Num() < NumDrawLists)
+		{
+			OutDrawLists.SetNum(NumDrawLists, EAllowShrinking::No);
+		}
 
 		for (int Index = 0; Index < DrawData->CmdListsCount; Index++)
 		{
-			DrawLists[StartIndex + Index].TransferDrawData(*DrawData->CmdLists[Index]);
+			OutDrawLists[StartIndex + Index].TransferDrawData(*DrawData->CmdLists[Index]);
+		}
+	}
+}
+
+FImGuiContextProxy::FFrameDrawDataRef FImGuiContextProxy::GetDrawData() const
+{
+	FScopeLock Lock(&PublishedFrameDrawDataLock);
+	return PublishedFrameDrawData;
+}
+
+TSharedRef<FImGuiFrameDrawData, ESPMode::ThreadSafe> FImGuiContextProxy::AcquireFrameDrawData()
+{
+	// A frame referenced only by the pool is neither published nor read by any consumer. New references can only be
+	// copied from the published frame, so it is safe to write to it.
+	for (const TSharedRef<FImGuiFrameDrawData, ESPMode::ThreadSafe>& Frame : FrameDrawDataPool)
+	{
+		if (Frame.GetSharedReferenceCount() == 1)
+		{
+			return Frame;
 		}
 	}
+
+	return FrameDrawDataPool.Add_GetRef(MakeShared<FImGuiFrameDrawData, ESPMode::ThreadSafe>());
+}
+
+const TArray<FImGuiSlateDrawList>& FImGuiContextProxy::GetSlateDrawData(const FTransform2D& Transform, const FSlateRect& ClippingRect)
+{
+	WaitForSlateDrawData();
+
+	if (!bHasSlateConversionParams || SlateFrameId != GetDrawData()->FrameId || SlateTransform != Transform
+		|| SlateClippingRect != ClippingRect)
+	{
+		ConvertSlateDrawData(Transform, ClippingRect, false);
+	}
+
+	return SlateDrawLists;
+}
+
+void FImGuiContextProxy::ConvertSlateDrawData(const FTransform2D& Transform, const FSlateRect& ClippingRect, bool bParallel)
+{
+	// Hold the snapshot, so it stays valid if a new frame is published during conversion.
+	const FFrameDrawDataRef FrameRef = GetDrawData();
+	const FImGuiFrameDrawData& Frame = *FrameRef;
+	const int32 NumDrawLists = Frame.NumDrawLists();
+
+	// Results of the last conversion become a cache for this one. Remaining entries are outdated, but we keep them to
+	// reuse their allocations.
+	Swap(SlateDrawLists, PreviousSlateDrawLists);
+	SlateDrawLists.SetNum(NumDrawLists, EAllowShrinking::No);
+
+	PreviousSlateDrawListIndices.Reset();
+	for (int32 Index = 0; Index < PreviousSlateDrawLists.Num(); Index++)
+	{
+		PreviousSlateDrawListIndices.Add(PreviousSlateDrawLists[Index].ContentHash, Index);
+	}
+
+	SlateDrawListsToConvert.Reset();
+	for (int32 Index = 0; Index < NumDrawLists; Index++)
+	{
+		int32 PreviousIndex;
+		if (PreviousSlateDrawListIndices.RemoveAndCopyValue(Frame.GetDrawList(Index).GetContentHash(), PreviousIndex)
+			&& PreviousSlateDrawLists[PreviousIndex].Transform == Transform
+			&& PreviousSlateDrawLists[PreviousIndex].ClippingRect == ClippingRect)
+		{
+			SlateDrawLists[Index] = MoveTemp(PreviousSlateDrawLists[PreviousIndex]);
+		}
+		else
+		{
+			SlateDrawListsToConvert.Add(Index);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_ImGuiSlateDrawListsReused, NumDrawLists - SlateDrawListsToConvert.Num());
+	INC_DWORD_STAT_BY(STAT_ImGuiSlateDrawListsConverted, SlateDrawListsToConvert.Num());
+
+	// Draw lists are independent, so they can be converted in parallel.
+	ParallelFor(SlateDrawListsToConvert.Num(), [&](int32 Idx)
+	{
+		const int32 Index = SlateDrawListsToConvert[Idx];
+		Frame.GetDrawList(Index).ConvertToSlate(SlateDrawLists[Index], Transform, ClippingRect);
+	}, !bParallel);
+
+	SlateTransform = Transform;
+	SlateClippingRect = ClippingRect;
+	SlateFrameId = Frame.FrameId;
+	bHasSlateConversionParams = true;
+}
+
+void FImGuiContextProxy::WaitForSlateDrawData()
+{
+	if (SlateConversionTask.IsValid())
+	{
+		SlateConversionTask.Wait();
+		SlateConversionTask = {};
+	}
 }
 
 void FImGuiContextProxy::BroadcastWorldEarlyDebug()
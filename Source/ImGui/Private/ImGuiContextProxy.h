@@ -7,6 +7,8 @@
 #include "Utilities/WorldContextIndex.h"
 
 #include <GenericPlatform/ICursor.h>
+#include <HAL/CriticalSection.h>
+#include <Tasks/Task.h>
 
 #include <imgui.h>
 
@@ -35,8 +37,21 @@ public:
 	// Get the index
 	const int32 GetContextIndex() const { return ContextIndex; }
 
-	// Get draw data from the last frame.
-	const TArray<FImGuiDrawList>& GetDrawData() const { return DrawLists; }
+	// Frame draw data shared with consumers.
+	using FFrameDrawDataRef = TSharedRef<const FImGuiFrameDrawData, ESPMode::ThreadSafe>;
+
+	// Get draw data from the last completed frame. Frames are published as immutable snapshots, so any number of
+	// consumers (Slate paint, background conversion, NetImgui) can read the latest frame, from any thread, while the
+	// next frame is produced. Consumers keep the snapshot alive as long as they hold the reference.
+	FFrameDrawDataRef GetDrawData() const;
+
+	// Get draw data from the last frame converted for Slate. Converted draw lists are cached and reconverted only when
+	// their content, transform or clipping rectangle change. If parallel conversion is enabled, data are converted in
+	// the background after each frame using parameters from the last call.
+	// @param Transform - Transform from ImGui to screen space
+	// @param ClippingRect - Clipping rectangle of the widget in which we draw
+	// @returns Draw lists converted for Slate
+	const TArray<FImGuiSlateDrawList>& GetSlateDrawData(const FTransform2D& Transform, const FSlateRect& ClippingRect);
 
 	// Get input state used by this context.
 	FImGuiInputState& GetInputState() { return InputState; }
@@ -48,6 +63,13 @@ public:
 	// Set this context as current ImGui context.
 	void SetAsCurrent() { ImGui::SetCurrentContext(Context); }
 
+	// Set the context that should receive ImGui calls made outside of draw events (e.g. from actor ticks). In frames
+	// skipped by throttling or idle frame skipping, this is a context whose output is discarded.
+	void SetAsCurrentForWorldTick()
+	{
+		ImGui::SetCurrentContext(bIsFrameStarted || !DiscardContext ? Context : DiscardContext);
+	}
+
 	// Get the desired context display size.
 	const FVector2D& GetDisplaySize() const { return DisplaySize; }
 
@@ -75,6 +97,9 @@ public:
 	// Cursor type desired by this context (updated once per frame during context update).
 	EMouseCursor::Type GetMouseCursor() const { return MouseCursor;  }
 
+	// Request this context to be updated in the next tick, even if it is idle.
+	void RequestRedraw() { bIsRedrawRequested = true; }
+
 	// Internal draw event used to draw module's examples and debug widgets. Unlike the delegates container, it is not
 	// passed when the module is reloaded, so all objects that are unloaded with the module should register here.
 	FSimpleMulticastDelegate& OnDraw() { return DrawEvent; }
@@ -93,7 +118,18 @@ private:
 	void BeginFrame(FImGuiContextManager* ContextManager, float DeltaTime = 1.f / 60.f);
 	void EndFrame(FImGuiContextManager& ContextManager);
 
-	void UpdateDrawData(ImDrawData* DrawData);
+	// Begin a frame in the discard context, ending the previous one. It receives calls made outside of draw events in
+	// frames that are skipped, so they don't reach this context.
+	void BeginDiscardFrame(float DeltaTime);
+	void EndDiscardFrame();
+
+	bool IsThrottled(float DeltaSeconds) const;
+	bool CanSkipFrame(FImGuiContextManager& ContextManager);
+
+	void UpdateDrawData(ImDrawData* DrawData, TArray<FImGuiDrawList>& OutDrawLists, int32& NumDrawLists);
+
+	void ConvertSlateDrawData(const FTransform2D& Transform, const FSlateRect& ClippingRect, bool bParallel);
+	void WaitForSlateDrawData();
 
 	void BroadcastWorldEarlyDebug();
 	void BroadcastMultiContextEarlyDebug();
@@ -103,6 +139,10 @@ private:
 
 	ImGuiContext* Context;
 
+	// Context that receives calls in skipped frames (created on demand).
+	ImGuiContext* DiscardContext = nullptr;
+	bool bIsDiscardFrameStarted = false;
+
 	FVector2D DisplaySize = FVector2D::ZeroVector;
 	float DPIScale = 1.f;
 
@@ -115,9 +155,40 @@ private:
 	bool bIsDrawEarlyDebugCalled = false;
 	bool bIsDrawDebugCalled = false;
 
+	// Update throttling and idle frame skipping state.
+	bool bIsRedrawRequested = true;
+	int32 NumActiveFramesLeft = 0;
+	float AccumulatedDeltaSeconds = 0.f;
+	float SecondsSinceUpdate = 0.f;
+
 	FImGuiInputState InputState;
 
-	TArray<FImGuiDrawList> DrawLists;
+	// Get a frame that is not referenced by consumers, to fill it with the next frame draw data.
+	TSharedRef<FImGuiFrameDrawData, ESPMode::ThreadSafe> AcquireFrameDrawData();
+
+	// Frames allocated for draw data. Frames not referenced outside of this pool are reused, together with allocations
+	// of their draw lists.
+	TArray<TSharedRef<FImGuiFrameDrawData, ESPMode::ThreadSafe>> FrameDrawDataPool;
+
+	// The last published frame. Lock is only held to copy or exchange the reference.
+	FFrameDrawDataRef PublishedFrameDrawData = MakeShared<FImGuiFrameDrawData, ESPMode::ThreadSafe>();
+	mutable FCriticalSection PublishedFrameDrawDataLock;
+	uint32 LastFrameId = 0;
+
+	// Draw lists converted for Slate and results of the previous conversion, with their content hash lookup.
+	TArray<FImGuiSlateDrawList> SlateDrawLists;
+	TArray<FImGuiSlateDrawList> PreviousSlateDrawLists;
+	TMap<uint64, int32> PreviousSlateDrawListIndices;
+	TArray<int32> SlateDrawListsToConvert;
+
+	// Parameters and frame of the last conversion.
+	FTransform2D SlateTransform;
+	FSlateRect SlateClippingRect;
+	uint32 SlateFrameId = 0;
+	bool bHasSlateConversionParams = false;
+
+	// Background conversion started after the end of the frame.
+	UE::Tasks::FTask SlateConversionTask;
 
 	FString Name;
 	int32 ContextIndex = Utilities::INVALID_CONTEXT_INDEX;
@@ -2,6 +2,7 @@
 
 #include "ImGuiDemo.h"
 
+#include "ImGuiModule.h"
 #include "ImGuiModuleProperties.h"
 
 #include <CoreGlobals.h>
@@ -14,6 +15,9 @@ void FImGuiDemo::DrawControls(int32 ContextIndex)
 	{
 		const int32 ContextBit = ContextIndex < 0 ? 0 : 1 << ContextIndex;
 
+		// Demo shows live values, so it needs to be updated in every frame.
+		FImGuiModule::Get().RequestRedraw();
+
 		// 1. Show a simple window
 		// Tip: if we don't call ImGui::Begin()/ImGui::End() the widgets appears in a window automatically called "Debug"
 		{
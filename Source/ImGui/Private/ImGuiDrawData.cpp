@@ -2,56 +2,387 @@
 
 #include "ImGuiDrawData.h"
 
+#include "ImGuiModuleDebug.h"
 
+#include <Hash/CityHash.h>
+#include <Math/VectorRegister.h>
+
+#include <type_traits>
+
+
+// With 32-bit ImGui indices, a single draw command can reference more vertices than 16-bit Slate indices can address.
+static_assert(sizeof(ImDrawIdx) <= sizeof(SlateIndex), "32-bit ImGui draw indices (IMGUI_USE_32BIT_DRAW_INDICES) require 32-bit SlateIndex.");
+
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Draw Commands"), STAT_ImGuiCulledDrawCommands, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Vertices"), STAT_ImGuiCulledVertices, STATGROUP_ImGui);
+
+
+namespace ImGuiVertexConversion
+{
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect) const
+	void CopyScalar(FSlateVertex* OutVertices, const ImDrawVert* InVertices, int32 NumVertices, const FTransform2D& Transform,
+		const FSlateRotatedRect& VertexClippingRect)
 #else
-void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform) const
+	void CopyScalar(FSlateVertex* OutVertices, const ImDrawVert* InVertices, int32 NumVertices, const FTransform2D& Transform)
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-{
-	// Reset and reserve space in destination buffer.
-	OutVertexBuffer.SetNumUninitialized(ImGuiVertexBuffer.Size, EAllowShrinking::No);
-
-	// Transform and copy vertex data.
-	for (int Idx = 0; Idx < ImGuiVertexBuffer.Size; Idx++)
 	{
-		const ImDrawVert& ImGuiVertex = ImGuiVertexBuffer[Idx];
-		FSlateVertex& SlateVertex = OutVertexBuffer[Idx];
+		for (int32 Idx = 0; Idx < NumVertices; Idx++)
+		{
+			const ImDrawVert& ImGuiVertex = InVertices[Idx];
+			FSlateVertex& SlateVertex = OutVertices[Idx];
 
-		// Final UV is calculated in shader as XY * ZW, so we need set all components.
-		SlateVertex.TexCoords[0] = ImGuiVertex.uv.x;
-		SlateVertex.TexCoords[1] = ImGuiVertex.uv.y;
-		SlateVertex.TexCoords[2] = SlateVertex.TexCoords[3] = 1.f;
+			// Final UV is calculated in shader as XY * ZW, so we need set all components.
+			SlateVertex.TexCoords[0] = ImGuiVertex.uv.x;
+			SlateVertex.TexCoords[1] = ImGuiVertex.uv.y;
+			SlateVertex.TexCoords[2] = SlateVertex.TexCoords[3] = 1.f;
 
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-		const FVector2D VertexPosition = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
-		SlateVertex.Position[0] = VertexPosition.X;
-		SlateVertex.Position[1] = VertexPosition.Y;
-		SlateVertex.ClipRect = VertexClippingRect;
+			const FVector2D VertexPosition = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
+			SlateVertex.Position[0] = VertexPosition.X;
+			SlateVertex.Position[1] = VertexPosition.Y;
+			SlateVertex.ClipRect = VertexClippingRect;
 #else
 #if ENGINE_COMPATIBILITY_LEGACY_VECTOR2F
-		SlateVertex.Position = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
+			SlateVertex.Position = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
 #else
-		SlateVertex.Position = (FVector2f)Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
+			SlateVertex.Position = (FVector2f)Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
 #endif // ENGINE_COMPATIBILITY_LEGACY_VECTOR2F
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
-		// Unpack ImU32 color.
-		SlateVertex.Color = ImGuiInterops::UnpackImU32Color(ImGuiVertex.col);
+			// Unpack ImU32 color.
+			SlateVertex.Color = ImGuiInterops::UnpackImU32Color(ImGuiVertex.col);
+		}
+	}
+
+#if IMGUI_VECTORIZED_VERTEX_CONVERSION
+	int32 CopyVectorized(FSlateVertex* RESTRICT OutVertices, const ImDrawVert* RESTRICT InVertices, int32 NumVertices,
+		const FTransform2D& Transform)
+	{
+		// Positions are transformed in the precision of FTransform2D, with separate multiplications and additions in the
+		// same order as in FTransform2D::TransformPoint, so results are identical to the scalar path.
+		static_assert(std::is_same<decltype(Transform.GetTranslation().X), double>::value,
+			"Vectorized vertex conversion expects double precision FTransform2D.");
+
+		double M00, M01, M10, M11;
+		Transform.GetMatrix().GetMatrix(M00, M01, M10, M11);
+		const FVector2D Translation = Transform.GetTranslation();
+
+		// Positions of two vertices are transformed in one register, so constants are repeated in both halves.
+		const VectorRegister4Double MatrixX = MakeVectorRegisterDouble(M00, M01, M00, M01);
+		const VectorRegister4Double MatrixY = MakeVectorRegisterDouble(M10, M11, M10, M11);
+		const VectorRegister4Double TranslationTT = MakeVectorRegisterDouble(Translation.X, Translation.Y, Translation.X, Translation.Y);
+		const VectorRegister4Float One = VectorOneFloat();
+
+		const VectorRegister4Int AlphaGreenMask = MakeVectorRegisterInt((int32)0xFF00FF00, (int32)0xFF00FF00, (int32)0xFF00FF00, (int32)0xFF00FF00);
+		const VectorRegister4Int ByteMask = MakeVectorRegisterInt(0xFF, 0xFF, 0xFF, 0xFF);
+
+		// Position = (X * M00 + Y * M10 + TX, X * M01 + Y * M11 + TY), for two vertices.
+		const auto TransformPositions = [&](const VectorRegister4Float& Positions)
+		{
+			const VectorRegister4Double PositionsDouble{ Positions };
+			return MakeVectorRegisterFloatFromDouble(VectorAdd(VectorAdd(
+				VectorMultiply(VectorSwizzle(PositionsDouble, 0, 0, 2, 2), MatrixX),
+				VectorMultiply(VectorSwizzle(PositionsDouble, 1, 1, 3, 3), MatrixY)), TranslationTT));
+		};
+
+		alignas(16) float Positions[2 * VerticesPerIteration];
+		alignas(16) uint32 Colors[VerticesPerIteration];
+
+		const int32 NumVectorized = NumVertices - NumVertices % VerticesPerIteration;
+		for (int32 Idx = 0; Idx < NumVectorized; Idx += VerticesPerIteration)
+		{
+			const ImDrawVert* Src = InVertices + Idx;
+			FSlateVertex* Dst = OutVertices + Idx;
+
+			// ImDrawVert starts with position followed by UV, so one load gives (pos.x, pos.y, uv.x, uv.y).
+			const VectorRegister4Float PosUV0 = VectorLoad(&Src[0].pos.x);
+			const VectorRegister4Float PosUV1 = VectorLoad(&Src[1].pos.x);
+			const VectorRegister4Float PosUV2 = VectorLoad(&Src[2].pos.x);
+			const VectorRegister4Float PosUV3 = VectorLoad(&Src[3].pos.x);
+
+			// Final UV is calculated in shader as XY * ZW, so we need set all components.
+			VectorStore(VectorShuffle(PosUV0, One, 2, 3, 0, 1), Dst[0].TexCoords);
+			VectorStore(VectorShuffle(PosUV1, One, 2, 3, 0, 1), Dst[1].TexCoords);
+			VectorStore(VectorShuffle(PosUV2, One, 2, 3, 0, 1), Dst[2].TexCoords);
+			VectorStore(VectorShuffle(PosUV3, One, 2, 3, 0, 1), Dst[3].TexCoords);
+
+			VectorStoreAligned(TransformPositions(VectorShuffle(PosUV0, PosUV1, 0, 1, 0, 1)), Positions);
+			VectorStoreAligned(TransformPositions(VectorShuffle(PosUV2, PosUV3, 0, 1, 0, 1)), Positions + 4);
+
+			// ImU32 is packed as ABGR and FColor as ARGB, so swap red and blue while keeping alpha and green in place.
+			const VectorRegister4Int Packed = MakeVectorRegisterInt((int32)Src[0].col, (int32)Src[1].col, (int32)Src[2].col, (int32)Src[3].col);
+			VectorIntStoreAligned(VectorIntOr(VectorIntAnd(Packed, AlphaGreenMask),
+				VectorIntOr(VectorIntAnd(VectorShiftRightImmLogical(Packed, 16), ByteMask),
+					VectorShiftLeftImm(VectorIntAnd(Packed, ByteMask), 16))), Colors);
+
+			for (int32 Lane = 0; Lane < VerticesPerIteration; Lane++)
+			{
+				Dst[Lane].Position = FVector2f{ Positions[2 * Lane], Positions[2 * Lane + 1] };
+				Dst[Lane].Color = FColor{ Colors[Lane] };
+			}
+		}
+
+		return NumVectorized;
 	}
+#endif // IMGUI_VECTORIZED_VERTEX_CONVERSION
+}
+
+
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, int32 FirstVertex,
+	int32 NumVertices, const FSlateRotatedRect& VertexClippingRect) const
+#else
+void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, int32 FirstVertex,
+	int32 NumVertices) const
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+{
+	check(FirstVertex >= 0 && FirstVertex + NumVertices <= FMath::Min(OutVertexBuffer.Num(), ImGuiVertexBuffer.Size));
+
+	FSlateVertex* OutVertices = OutVertexBuffer.GetData() + FirstVertex;
+	const ImDrawVert* InVertices = ImGuiVertexBuffer.Data + FirstVertex;
+	int32 NumConverted = 0;
+
+#if IMGUI_VECTORIZED_VERTEX_CONVERSION
+	// Convert bulk of the data in vectorized blocks.
+	NumConverted = ImGuiVertexConversion::CopyVectorized(OutVertices, InVertices, NumVertices, Transform);
+#endif // IMGUI_VECTORIZED_VERTEX_CONVERSION
+
+	// Transform and copy vertex data (or remaining tail of vectorized conversion).
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	ImGuiVertexConversion::CopyScalar(OutVertices + NumConverted, InVertices + NumConverted, NumVertices - NumConverted, Transform,
+		VertexClippingRect);
+#else
+	ImGuiVertexConversion::CopyScalar(OutVertices + NumConverted, InVertices + NumConverted, NumVertices - NumConverted, Transform);
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 }
 
-void FImGuiDrawList::CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const
+void FImGuiDrawList::CopyIndexData(SlateIndex* OutIndices, const int32 StartIndex, const int32 NumElements,
+	int32& OutFirstVertex, int32& OutNumVertices) const
 {
-	// Reset buffer.
-	OutIndexBuffer.SetNumUninitialized(NumElements, EAllowShrinking::No);
+	if (NumElements <= 0)
+	{
+		OutFirstVertex = OutNumVertices = 0;
+		return;
+	}
+
+	// Find range of referenced vertices.
+	const ImDrawIdx* SourceIndices = ImGuiIndexBuffer.Data + StartIndex;
+	ImDrawIdx MinIndex = SourceIndices[0];
+	ImDrawIdx MaxIndex = SourceIndices[0];
+	for (int i = 1; i < NumElements; i++)
+	{
+		MinIndex = FMath::Min(MinIndex, SourceIndices[i]);
+		MaxIndex = FMath::Max(MaxIndex, SourceIndices[i]);
+	}
 
-	// Copy elements (slow copy because of different sizes of ImDrawIdx and SlateIndex and because SlateIndex can
-	// have different size on different platforms).
-	for (int i = 0; i < NumElements; i++)
+	// Copy elements rebased to the start of that range. If index types match and no rebasing is needed, this is a plain
+	// memory copy (ImDrawIdx and SlateIndex can have different sizes, depending on configuration and platform).
+	if (sizeof(ImDrawIdx) == sizeof(SlateIndex) && MinIndex == 0)
+	{
+		FMemory::Memcpy(OutIndices, SourceIndices, NumElements * sizeof(SlateIndex));
+	}
+	else
 	{
-		OutIndexBuffer[i] = ImGuiIndexBuffer[StartIndex + i];
+		for (int i = 0; i < NumElements; i++)
+		{
+			OutIndices[i] = static_cast<SlateIndex>(SourceIndices[i] - MinIndex);
+		}
 	}
+
+	OutFirstVertex = MinIndex;
+	OutNumVertices = MaxIndex - MinIndex + 1;
+}
+
+namespace
+{
+	FORCEINLINE FVector2D GetVertexPosition(const FSlateVertex& Vertex)
+	{
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+		return FVector2D{ Vertex.Position[0], Vertex.Position[1] };
+#else
+		return FVector2D{ Vertex.Position.X, Vertex.Position.Y };
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	}
+
+	// Remove triangles that are completely outside of the clipping rectangle.
+	// @param OutIndices - Destination for remaining indices (can be the same as or precede source indices)
+	// @param Indices - Triangle list indices to filter
+	// @param NumIndices - Number of indices
+	// @param Vertices - Vertices referenced by indices
+	// @param ClippingRect - Clipping rectangle in the same space as vertices
+	// @param bOutNeedsClipping - Set to true if any of the remaining triangles crosses the clipping rectangle
+	// @returns Number of indices left after culling
+	int32 CullTriangles(SlateIndex* OutIndices, const SlateIndex* Indices, int32 NumIndices, const FSlateVertex* Vertices, const FSlateRect& ClippingRect,
+		bool& bOutNeedsClipping)
+	{
+		bOutNeedsClipping = false;
+
+		int32 NumVisible = 0;
+		for (int32 Idx = 0; Idx + 2 < NumIndices; Idx += 3)
+		{
+			const FVector2D A = GetVertexPosition(Vertices[Indices[Idx]]);
+			const FVector2D B = GetVertexPosition(Vertices[Indices[Idx + 1]]);
+			const FVector2D C = GetVertexPosition(Vertices[Indices[Idx + 2]]);
+
+			const FVector2D Min{ FMath::Min3(A.X, B.X, C.X), FMath::Min3(A.Y, B.Y, C.Y) };
+			const FVector2D Max{ FMath::Max3(A.X, B.X, C.X), FMath::Max3(A.Y, B.Y, C.Y) };
+
+			if (Max.X <= ClippingRect.Left || Min.X >= ClippingRect.Right || Max.Y <= ClippingRect.Top || Min.Y >= ClippingRect.Bottom)
+			{
+				continue;
+			}
+
+			bOutNeedsClipping |= (Min.X < ClippingRect.Left || Max.X > ClippingRect.Right || Min.Y < ClippingRect.Top || Max.Y > ClippingRect.Bottom);
+
+			const SlateIndex I0 = Indices[Idx], I1 = Indices[Idx + 1], I2 = Indices[Idx + 2];
+			OutIndices[NumVisible++] = I0;
+			OutIndices[NumVisible++] = I1;
+			OutIndices[NumVisible++] = I2;
+		}
+
+		return NumVisible;
+	}
+}
+
+void FImGuiDrawList::ConvertToSlate(FImGuiSlateDrawList& Out, const FTransform2D& Transform, const FSlateRect& ClippingRect) const
+{
+	Out.ContentHash = ContentHash;
+	Out.Transform = Transform;
+	Out.ClippingRect = ClippingRect;
+
+	// Vertices keep their positions from the source buffer, but only ranges used by visible commands are converted.
+	Out.Vertices.SetNumUninitialized(ImGuiVertexBuffer.Size, EAllowShrinking::No);
+	Out.Indices.SetNum(0, EAllowShrinking::No);
+	Out.Commands.SetNum(0, EAllowShrinking::No);
+
+	// Ranges of vertices referenced by commands that are not culled (begin and end).
+	TArray<TPair<int32, int32>, TInlineAllocator<32>> VertexRanges;
+
+	// Drop commands clipped by the widget and copy indices of the remaining ones, rebased to the range of vertices that
+	// they use.
+	int32 IndexBufferOffset = 0;
+	for (int CommandNb = 0; CommandNb < NumCommands(); CommandNb++)
+	{
+		const FImGuiDrawCommand DrawCommand = GetCommand(CommandNb, Transform);
+
+		const int32 StartIndex = IndexBufferOffset;
+		IndexBufferOffset += DrawCommand.NumElements;
+
+		bool bIsVisible;
+		const FSlateRect CommandClippingRect = DrawCommand.ClippingRect.IntersectionWith(ClippingRect, bIsVisible);
+		if (!bIsVisible)
+		{
+			INC_DWORD_STAT(STAT_ImGuiCulledDrawCommands);
+			continue;
+		}
+
+		const int32 FirstIndex = Out.Indices.Num();
+		Out.Indices.AddUninitialized(DrawCommand.NumElements);
+
+		int32 FirstVertex, NumVertices;
+		CopyIndexData(Out.Indices.GetData() + FirstIndex, StartIndex, DrawCommand.NumElements, FirstVertex, NumVertices);
+		FirstVertex += DrawCommand.VertexOffset;
+
+		if (NumVertices > 0)
+		{
+			VertexRanges.Emplace(FirstVertex, FirstVertex + NumVertices);
+		}
+
+		Out.Commands.Add({ CommandClippingRect, DrawCommand.TextureId, FirstVertex, NumVertices, FirstIndex,
+			(int32)DrawCommand.NumElements });
+	}
+
+	// Convert vertices used by remaining commands. Ranges can overlap (e.g. when draw list channels were merged), so
+	// we sort and merge them first.
+	VertexRanges.Sort([](const TPair<int32, int32>& Lhs, const TPair<int32, int32>& Rhs) { return Lhs.Key < Rhs.Key; });
+
+	int32 NumConvertedVertices = 0;
+	for (int32 RangeIdx = 0; RangeIdx < VertexRanges.Num();)
+	{
+		const int32 Begin = VertexRanges[RangeIdx].Key;
+		int32 End = VertexRanges[RangeIdx].Value;
+		for (RangeIdx++; RangeIdx < VertexRanges.Num() && VertexRanges[RangeIdx].Key <= End; RangeIdx++)
+		{
+			End = FMath::Max(End, VertexRanges[RangeIdx].Value);
+		}
+
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+		CopyVertexData(Out.Vertices, Transform, Begin, End - Begin, FSlateRotatedRect{ ClippingRect });
+#else
+		CopyVertexData(Out.Vertices, Transform, Begin, End - Begin);
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+		NumConvertedVertices += End - Begin;
+	}
+
+	INC_DWORD_STAT_BY(STAT_ImGuiCulledVertices, ImGuiVertexBuffer.Size - NumConvertedVertices);
+
+	// Drop triangles that are completely clipped, compacting indices and commands that remain.
+	int32 NumIndices = 0;
+	int32 NumVisibleCommands = 0;
+	for (int32 CommandIdx = 0; CommandIdx < Out.Commands.Num(); CommandIdx++)
+	{
+		FImGuiSlateDrawCommand Command = Out.Commands[CommandIdx];
+
+		bool bNeedsClipping;
+		const int32 NumVisibleIndices = CullTriangles(Out.Indices.GetData() + NumIndices, Out.Indices.GetData() + Command.FirstIndex,
+			Command.NumIndices, Out.Vertices.GetData() + Command.FirstVertex, Command.ClippingRect, bNeedsClipping);
+
+		if (NumVisibleIndices > 0)
+		{
+			// If none of the remaining triangles crosses the command clipping rectangle, widget clipping gives the same
+			// result, which allows to batch commands that differ only in their clipping rectangles.
+			if (!bNeedsClipping)
+			{
+				Command.ClippingRect = ClippingRect;
+			}
+
+			Command.FirstIndex = NumIndices;
+			Command.NumIndices = NumVisibleIndices;
+			Out.Commands[NumVisibleCommands++] = Command;
+
+			NumIndices += NumVisibleIndices;
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_ImGuiCulledDrawCommands);
+		}
+	}
+
+	Out.Indices.SetNum(NumIndices, EAllowShrinking::No);
+	Out.Commands.SetNum(NumVisibleCommands, EAllowShrinking::No);
+}
+
+bool FImGuiSlateDrawBatch::CanAdd(const FImGuiSlateDrawCommand& Command) const
+{
+	return IsEmpty() || (TextureId == Command.TextureId && ClippingRect == Command.ClippingRect
+		&& (int64)Vertices.Num() + Command.NumVertices <= (int64)TNumericLimits<SlateIndex>::Max() + 1);
+}
+
+void FImGuiSlateDrawBatch::Add(const FImGuiSlateDrawList& DrawList, const FImGuiSlateDrawCommand& Command)
+{
+	if (IsEmpty())
+	{
+		TextureId = Command.TextureId;
+		ClippingRect = Command.ClippingRect;
+	}
+
+	const SlateIndex BaseIndex = static_cast<SlateIndex>(Vertices.Num());
+	Vertices.Append(DrawList.Vertices.GetData() + Command.FirstVertex, Command.NumVertices);
+
+	const int32 FirstIndex = Indices.AddUninitialized(Command.NumIndices);
+	for (int32 Idx = 0; Idx < Command.NumIndices; Idx++)
+	{
+		Indices[FirstIndex + Idx] = BaseIndex + DrawList.Indices[Command.FirstIndex + Idx];
+	}
+}
+
+void FImGuiSlateDrawBatch::Reset()
+{
+	Vertices.SetNum(0, EAllowShrinking::No);
+	Indices.SetNum(0, EAllowShrinking::No);
+	TextureId = INDEX_NONE;
 }
 
 void FImGuiDrawList::TransferDrawData(ImDrawList& Src)
@@ -60,4 +391,10 @@ void FImGuiDrawList::TransferDrawData(ImDrawList& Src)
 	Src.CmdBuffer.swap(ImGuiCommandBuffer);
 	Src.IdxBuffer.swap(ImGuiIndexBuffer);
 	Src.VtxBuffer.swap(ImGuiVertexBuffer);
+
+	// Hash content, so data converted for Slate can be reused for as long as it doesn't change. Draw commands are
+	// zero-initialized by ImGui, so it is safe to hash them including padding.
+	ContentHash = CityHash64(reinterpret_cast<const char*>(ImGuiVertexBuffer.Data), ImGuiVertexBuffer.size_in_bytes());
+	ContentHash = CityHash64WithSeed(reinterpret_cast<const char*>(ImGuiIndexBuffer.Data), ImGuiIndexBuffer.size_in_bytes(), ContentHash);
+	ContentHash = CityHash64WithSeed(reinterpret_cast<const char*>(ImGuiCommandBuffer.Data), ImGuiCommandBuffer.size_in_bytes(), ContentHash);
 }
@@ -10,6 +10,45 @@
 #include <imgui.h>
 
 
+// Vectorized vertex conversion needs float vector registers (UE5) and the default ImGui colour packing, for which
+// conversion to FColor is a swap of red and blue channels.
+#ifndef IMGUI_VECTORIZED_VERTEX_CONVERSION
+#define IMGUI_VECTORIZED_VERTEX_CONVERSION (!ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API && !ENGINE_COMPATIBILITY_LEGACY_VECTOR2F \
+	&& IM_COL32_R_SHIFT == 0 && IM_COL32_G_SHIFT == 8 && IM_COL32_B_SHIFT == 16 && IM_COL32_A_SHIFT == 24)
+#endif
+
+// Vertex conversion paths used by FImGuiDrawList. Both paths give identical results, which is verified by automation
+// tests.
+namespace ImGuiVertexConversion
+{
+	// Transform and copy vertices one at a time.
+	// @param OutVertices - Destination vertices
+	// @param InVertices - Source ImGui vertices
+	// @param NumVertices - Number of vertices to convert
+	// @param Transform - Transform to apply to all vertices
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// @param VertexClippingRect - Clipping rectangle for transformed Slate vertices
+	void CopyScalar(FSlateVertex* OutVertices, const ImDrawVert* InVertices, int32 NumVertices, const FTransform2D& Transform,
+		const FSlateRotatedRect& VertexClippingRect);
+#else
+	void CopyScalar(FSlateVertex* OutVertices, const ImDrawVert* InVertices, int32 NumVertices, const FTransform2D& Transform);
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+#if IMGUI_VECTORIZED_VERTEX_CONVERSION
+	// Number of vertices converted in one iteration of the vectorized loop.
+	constexpr int32 VerticesPerIteration = 4;
+
+	// Transform and copy vertices in blocks of VerticesPerIteration.
+	// @param OutVertices - Destination vertices
+	// @param InVertices - Source ImGui vertices
+	// @param NumVertices - Number of source vertices
+	// @param Transform - Transform to apply to all vertices
+	// @returns Number of converted vertices (the remaining tail is left for the scalar path)
+	int32 CopyVectorized(FSlateVertex* RESTRICT OutVertices, const ImDrawVert* RESTRICT InVertices, int32 NumVertices,
+		const FTransform2D& Transform);
+#endif // IMGUI_VECTORIZED_VERTEX_CONVERSION
+}
+
 // ImGui draw command data transformed for Slate.
 struct FImGuiDrawCommand
 {
@@ -19,6 +58,59 @@ struct FImGuiDrawCommand
 	TextureIndex TextureId;
 };
 
+// Draw command converted for Slate. Indices of the command are relative to its first vertex.
+struct FImGuiSlateDrawCommand
+{
+	FSlateRect ClippingRect;
+	TextureIndex TextureId;
+	int32 FirstVertex;
+	int32 NumVertices;
+	int32 FirstIndex;
+	int32 NumIndices;
+};
+
+// Draw list converted for Slate: vertices transformed to screen space, triangles culled against clipping rectangles and
+// commands ready to be batched into Slate elements.
+struct FImGuiSlateDrawList
+{
+	TArray<FSlateVertex> Vertices;
+	TArray<SlateIndex> Indices;
+	TArray<FImGuiSlateDrawCommand> Commands;
+
+	// Source content and conversion parameters, used to decide whether converted data can be reused.
+	uint64 ContentHash = 0;
+	FTransform2D Transform;
+	FSlateRect ClippingRect;
+};
+
+// Consecutive Slate draw commands with the same texture and clipping rectangle, merged so they can be submitted as
+// a single Slate element.
+struct FImGuiSlateDrawBatch
+{
+	TArray<FSlateVertex> Vertices;
+	TArray<SlateIndex> Indices;
+	TextureIndex TextureId = INDEX_NONE;
+	FSlateRect ClippingRect;
+
+	// Check whether this batch has no data to submit.
+	bool IsEmpty() const { return Indices.Num() == 0; }
+
+	// Check whether command can be added to this batch. Empty batch accepts any command, otherwise command needs to use
+	// the same texture and clipping rectangle, and all batch vertices need to stay addressable by SlateIndex.
+	// @param Command - Command to check
+	// @returns True, if command can be added to this batch
+	bool CanAdd(const FImGuiSlateDrawCommand& Command) const;
+
+	// Add vertices used by command and indices rebased to their position in this batch. Empty batch takes texture and
+	// clipping rectangle from the added command.
+	// @param DrawList - Draw list with command data
+	// @param Command - Command to add
+	void Add(const FImGuiSlateDrawList& DrawList, const FImGuiSlateDrawCommand& Command);
+
+	// Clear batch data, keeping allocated memory.
+	void Reset();
+};
+
 // Wraps raw ImGui draw list data in utilities that transform them for Slate.
 class FImGuiDrawList
 {
@@ -38,32 +130,85 @@ public:
 			ImGuiInterops::ToTextureIndex(ImGuiCommand.TextureId) };
 	}
 
+	// Get hash of the draw list content, calculated when data are transferred from ImGui.
+	uint64 GetContentHash() const { return ContentHash; }
+
+	// Convert draw list for Slate (old data in the target are replaced).
+	// @param Out - Destination for converted data
+	// @param Transform - Transform to apply to all vertices and clipping rectangles
+	// @param ClippingRect - Clipping rectangle of the widget in which we draw, used to cull commands and triangles
+	void ConvertToSlate(FImGuiSlateDrawList& Out, const FTransform2D& Transform, const FSlateRect& ClippingRect) const;
+
+	// Transfers data from ImGui source list to this object. Leaves source cleared.
+	void TransferDrawData(ImDrawList& Src);
+
+private:
+
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-	// Transform and copy vertex data to target buffer (old data in the target buffer are replaced).
+	// Transform and copy a range of vertex data to the same range in target buffer (target needs to be large enough).
 	// @param OutVertexBuffer - Destination buffer
-	// @param Transform - Transform to apply to all vertices
+	// @param Transform - Transform to apply to vertices
+	// @param FirstVertex - Index of the first vertex to copy
+	// @param NumVertices - Number of vertices to copy
 	// @param VertexClippingRect - Clipping rectangle for transformed Slate vertices
-	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect) const;
+	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, int32 FirstVertex, int32 NumVertices,
+		const FSlateRotatedRect& VertexClippingRect) const;
 #else
-	// Transform and copy vertex data to target buffer (old data in the target buffer are replaced).
+	// Transform and copy a range of vertex data to the same range in target buffer (target needs to be large enough).
 	// @param OutVertexBuffer - Destination buffer
-	// @param Transform - Transform to apply to all vertices
-	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform) const;
+	// @param Transform - Transform to apply to vertices
+	// @param FirstVertex - Index of the first vertex to copy
+	// @param NumVertices - Number of vertices to copy
+	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, int32 FirstVertex, int32 NumVertices) const;
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
-	// Transform and copy index data to target buffer (old data in the target buffer are replaced).
-	// Internal index buffer contains enough data to match the sum of NumElements from all draw commands.
-	// @param OutIndexBuffer - Destination buffer
+	// Copy index data to target memory, rebased so that the lowest referenced vertex has index zero. Internal index
+	// buffer contains enough data to match the sum of NumElements from all draw commands.
+	// @param OutIndices - Destination with space for NumElements indices
 	// @param StartIndex - Start copying source data starting from this index
 	// @param NumElements - How many elements we want to copy
-	void CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const;
-
-	// Transfers data from ImGui source list to this object. Leaves source cleared.
-	void TransferDrawData(ImDrawList& Src);
-
-private:
+	// @param OutFirstVertex - Lowest vertex index referenced by copied elements (relative to command vertex offset)
+	// @param OutNumVertices - Number of vertices in range referenced by copied elements
+	void CopyIndexData(SlateIndex* OutIndices, const int32 StartIndex, const int32 NumElements, int32& OutFirstVertex,
+		int32& OutNumVertices) const;
 
 	ImVector<ImDrawCmd> ImGuiCommandBuffer;
 	ImVector<ImDrawIdx> ImGuiIndexBuffer;
 	ImVector<ImDrawVert> ImGuiVertexBuffer;
+
+	uint64 ContentHash = 0;
+};
+
+// Immutable snapshot of draw data received from a remote NetImgui client. Snapshots are shared by reference between
+// the net control and published frames, so a remote frame is transferred and hashed only once, when it arrives.
+struct FImGuiRemoteDrawData
+{
+	TArray<FImGuiDrawList> DrawLists;
+};
+
+// Draw data produced by one ImGui frame.
+struct FImGuiFrameDrawData
+{
+	// Draw lists received from a remote client, drawn under the local ones (shared, so must not be modified).
+	TSharedPtr<const FImGuiRemoteDrawData, ESPMode::ThreadSafe> RemoteDrawData;
+
+	// Draw lists produced by the local context.
+	TArray<FImGuiDrawList> DrawLists;
+
+	// Sequential number of the frame (zero if no frame was produced yet).
+	uint32 FrameId = 0;
+
+	// Get the number of remote and local draw lists in this frame.
+	int32 NumDrawLists() const { return NumRemoteDrawLists() + DrawLists.Num(); }
+
+	// Get the draw list by number, where remote draw lists come before the local ones.
+	const FImGuiDrawList& GetDrawList(int32 Index) const
+	{
+		const int32 NumRemote = NumRemoteDrawLists();
+		return Index < NumRemote ? RemoteDrawData->DrawLists[Index] : DrawLists[Index - NumRemote];
+	}
+
+private:
+
+	int32 NumRemoteDrawLists() const { return RemoteDrawData.IsValid() ? RemoteDrawData->DrawLists.Num() : 0; }
 };
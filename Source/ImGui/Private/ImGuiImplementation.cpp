@@ -72,4 +72,14 @@ namespace ImGuiImplementation
 		ImGuiContextPtrHandle.SetParent(&Parent);
 	}
 #endif // WITH_EDITOR
+
+	void InitRectPacker(stbrp_context* Context, int Width, int Height, stbrp_node* Nodes, int NumNodes)
+	{
+		stbrp_init_target(Context, Width, Height, Nodes, NumNodes);
+	}
+
+	bool PackRects(stbrp_context* Context, stbrp_rect* Rects, int NumRects)
+	{
+		return stbrp_pack_rects(Context, Rects, NumRects) != 0;
+	}
 }
@@ -3,6 +3,9 @@
 #pragma once
 
 struct FImGuiContextHandle;
+struct stbrp_context;
+struct stbrp_node;
+struct stbrp_rect;
 
 // Gives access to selected ImGui implementation features.
 namespace ImGuiImplementation
@@ -14,4 +17,19 @@ namespace ImGuiImplementation
 	// Set the ImGui Context pointer handle.
 	void SetParentContextHandle(FImGuiContextHandle& Parent);
 #endif // WITH_EDITOR
+
+	// Initialize a rectangle packer (imstb_rectpack, which implementation is built with ImGui).
+	// @param Context - Packer to initialize
+	// @param Width - Width of the packed area
+	// @param Height - Height of the packed area
+	// @param Nodes - Storage for the packer, which must stay valid as long as the packer is used
+	// @param NumNodes - Number of nodes, for the best results equal to the width
+	void InitRectPacker(stbrp_context* Context, int Width, int Height, stbrp_node* Nodes, int NumNodes);
+
+	// Pack rectangles. Packed rectangles have their position set and was_packed flag raised.
+	// @param Context - Packer to use
+	// @param Rects - Rectangles to pack
+	// @param NumRects - Number of rectangles
+	// @returns True, if all rectangles were packed
+	bool PackRects(stbrp_context* Context, stbrp_rect* Rects, int NumRects);
 }
@@ -15,6 +15,7 @@ FImGuiInputState::FImGuiInputState()
 void FImGuiInputState::AddCharacter(TCHAR Char)
 {
 	InputCharacters.Add(Char);
+	bHasUpdates = true;
 }
 
 void FImGuiInputState::SetKeyDown(uint32 KeyIndex, bool bIsDown)
@@ -25,6 +26,7 @@ void FImGuiInputState::SetKeyDown(uint32 KeyIndex, bool bIsDown)
 		{
 			KeysDown[KeyIndex] = bIsDown;
 			KeysUpdateRange.AddPosition(KeyIndex);
+			bHasUpdates = true;
 		}
 	}
 }
@@ -37,6 +39,7 @@ void FImGuiInputState::SetMouseDown(uint32 MouseIndex, bool bIsDown)
 		{
 			MouseButtonsDown[MouseIndex] = bIsDown;
 			MouseButtonsUpdateRange.AddPosition(MouseIndex);
+			bHasUpdates = true;
 		}
 	}
 }
@@ -54,6 +57,8 @@ void FImGuiInputState::ClearUpdateState()
 	MouseWheelDelta = 0.f;
 
 	bTouchProcessed = bTouchDown;
+
+	bHasUpdates = false;
 }
 
 void FImGuiInputState::ClearCharacters()
@@ -68,6 +73,7 @@ void FImGuiInputState::ClearKeys()
 
 	// Mark the whole array as dirty because potentially each entry could be affected.
 	KeysUpdateRange.SetFull();
+	bHasUpdates = true;
 }
 
 void FImGuiInputState::ClearMouseButtons()
@@ -77,12 +83,14 @@ void FImGuiInputState::ClearMouseButtons()
 
 	// Mark the whole array as dirty because potentially each entry could be affected.
 	MouseButtonsUpdateRange.SetFull();
+	bHasUpdates = true;
 }
 
 void FImGuiInputState::ClearMouseAnalogue()
 {
 	MousePosition = FVector2D::ZeroVector;
 	MouseWheelDelta = 0.f;
+	bHasUpdates = true;
 }
 
 void FImGuiInputState::ClearModifierKeys()
@@ -90,11 +98,13 @@ void FImGuiInputState::ClearModifierKeys()
 	bIsControlDown = false;
 	bIsShiftDown = false;
 	bIsAltDown = false;
+	bHasUpdates = true;
 }
 
 void FImGuiInputState::ClearNavigationInputs()
 {
 	using std::fill;
 	fill(NavigationInputs, &NavigationInputs[Utilities::GetArraySize(NavigationInputs)], 0.f);
+	bHasUpdates = true;
 }
 
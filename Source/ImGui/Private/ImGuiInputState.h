@@ -79,21 +79,21 @@ public:
 
 	// Add mouse wheel delta.
 	// @param DeltaValue - Mouse wheel delta to add
-	void AddMouseWheelDelta(float DeltaValue) { MouseWheelDelta += DeltaValue; }
+	void AddMouseWheelDelta(float DeltaValue) { MouseWheelDelta += DeltaValue; bHasUpdates |= (DeltaValue != 0.f); }
 
 	// Get the mouse position.
 	const FVector2D& GetMousePosition() const { return MousePosition; }
 
 	// Set the mouse position.
 	// @param Position - Mouse position
-	void SetMousePosition(const FVector2D& Position) { MousePosition = Position; }
+	void SetMousePosition(const FVector2D& Position) { UpdateValue(MousePosition, Position); }
 
 	// Check whether input has active mouse pointer.
 	bool HasMousePointer() const { return bHasMousePointer; }
 
 	// Set whether input has active mouse pointer.
 	// @param bHasPointer - True, if input has active mouse pointer
-	void SetMousePointer(bool bInHasMousePointer) { bHasMousePointer = bInHasMousePointer; }
+	void SetMousePointer(bool bInHasMousePointer) { UpdateValue(bHasMousePointer, bInHasMousePointer); }
 
 	// Check whether touch input is in progress. True, after touch is started until one frame after it has ended.
 	// One frame delay is used to process mouse release in ImGui since touch-down is simulated with mouse-down.
@@ -104,35 +104,35 @@ public:
 
 	// Set whether touch input is down.
 	// @param bIsDown - True, if touch is down (or started) and false, if touch is up (or ended)
-	void SetTouchDown(bool bIsDown) { bTouchDown = bIsDown; }
+	void SetTouchDown(bool bIsDown) { UpdateValue(bTouchDown, bIsDown); }
 
 	// Get the touch position.
 	const FVector2D& GetTouchPosition() const { return TouchPosition; }
 
 	// Set the touch position.
 	// @param Position - Touch position
-	void SetTouchPosition(const FVector2D& Position) { TouchPosition = Position; }
+	void SetTouchPosition(const FVector2D& Position) { UpdateValue(TouchPosition, Position); }
 
 	// Get Control down state.
 	bool IsControlDown() const { return bIsControlDown; }
 
 	// Set Control down state.
 	// @param bIsDown - True, if Control is down
-	void SetControlDown(bool bIsDown) { bIsControlDown = bIsDown; }
+	void SetControlDown(bool bIsDown) { UpdateValue(bIsControlDown, bIsDown); }
 
 	// Get Shift down state.
 	bool IsShiftDown() const { return bIsShiftDown; }
 
 	// Set Shift down state.
 	// @param bIsDown - True, if Shift is down
-	void SetShiftDown(bool bIsDown) { bIsShiftDown = bIsDown; }
+	void SetShiftDown(bool bIsDown) { UpdateValue(bIsShiftDown, bIsDown); }
 
 	// Get Alt down state.
 	bool IsAltDown() const { return bIsAltDown; }
 
 	// Set Alt down state.
 	// @param bIsDown - True, if Alt is down
-	void SetAltDown(bool bIsDown) { bIsAltDown = bIsDown; }
+	void SetAltDown(bool bIsDown) { UpdateValue(bIsAltDown, bIsDown); }
 
 	// Get reference to the array with navigation input states.
 	const FNavInputArray& GetNavigationInputs() const { return NavigationInputs; }
@@ -140,12 +140,12 @@ public:
 	// Change state of the navigation input associated with this gamepad key.
 	// @param KeyEvent - Key event with gamepad key input
 	// @param bIsDown - True, if key is down
-	void SetGamepadNavigationKey(const FKeyEvent& KeyEvent, bool bIsDown) { ImGuiInterops::SetGamepadNavigationKey(NavigationInputs, KeyEvent.GetKey(), bIsDown); }
+	void SetGamepadNavigationKey(const FKeyEvent& KeyEvent, bool bIsDown) { ImGuiInterops::SetGamepadNavigationKey(NavigationInputs, KeyEvent.GetKey(), bIsDown); bHasUpdates = true; }
 
 	// Change state of the navigation input associated with this gamepad axis.
 	// @param AnalogInputEvent - Analogue input event with gamepad axis input
 	// @param Value - Analogue value that should be set for this axis
-	void SetGamepadNavigationAxis(const FAnalogInputEvent& AnalogInputEvent, float Value) { ImGuiInterops::SetGamepadNavigationAxis(NavigationInputs, AnalogInputEvent.GetKey(), Value); }
+	void SetGamepadNavigationAxis(const FAnalogInputEvent& AnalogInputEvent, float Value) { ImGuiInterops::SetGamepadNavigationAxis(NavigationInputs, AnalogInputEvent.GetKey(), Value); bHasUpdates = true; }
 
 	// Check whether keyboard navigation is enabled.
 	bool IsKeyboardNavigationEnabled() const { return bKeyboardNavigationEnabled; }
@@ -197,6 +197,9 @@ public:
 		ClearNavigationInputs();
 	}
 
+	// Check whether input state changed since the last call to ClearUpdateState.
+	bool HasUpdates() const { return bHasUpdates; }
+
 	// Clear part of the state that is meant to be updated in every frame like: accumulators, buffers, navigation data
 	// and information about dirty parts of keys or mouse buttons arrays.
 	void ClearUpdateState();
@@ -209,6 +212,16 @@ private:
 	void SetKeyDown(uint32 KeyIndex, bool bIsDown);
 	void SetMouseDown(uint32 MouseIndex, bool IsDown);
 
+	template<typename T>
+	void UpdateValue(T& Value, const T& NewValue)
+	{
+		if (Value != NewValue)
+		{
+			Value = NewValue;
+			bHasUpdates = true;
+		}
+	}
+
 	void ClearCharacters();
 	void ClearKeys();
 	void ClearMouseButtons();
@@ -241,4 +254,6 @@ private:
 	bool bKeyboardNavigationEnabled = false;
 	bool bGamepadNavigationEnabled = false;
 	bool bHasGamepad = false;
+
+	bool bHasUpdates = true;
 };
@@ -85,8 +85,21 @@ void FImGuiModule::RemoveImGuiDelegate(const FImGuiDelegateHandle& Handle)
 
 FImGuiTextureHandle FImGuiModule::FindTextureHandle(const FName& Name)
 {
-	const TextureIndex Index = ImGuiModuleManager->GetTextureManager().FindTextureIndex(Name);
-	return (Index != INDEX_NONE) ? FImGuiTextureHandle{ Name, ImGuiInterops::ToImTextureID(Index) } : FImGuiTextureHandle{};
+	FTextureManager& TextureManager = ImGuiModuleManager->GetTextureManager();
+
+	const TextureIndex Index = TextureManager.FindTextureIndex(Name);
+	if (Index != INDEX_NONE)
+	{
+		return FImGuiTextureHandle{ Name, ImGuiInterops::ToImTextureID(Index) };
+	}
+
+	FTextureManager::FIconLocation Icon;
+	if (TextureManager.FindIcon(Name, Icon))
+	{
+		return FImGuiTextureHandle{ Name, ImGuiInterops::ToImTextureID(Icon.Index), ImGuiInterops::ToImVec2(Icon.UV0), ImGuiInterops::ToImVec2(Icon.UV1) };
+	}
+
+	return FImGuiTextureHandle{};
 }
 
 FImGuiTextureHandle FImGuiModule::RegisterTexture(const FName& Name, class UTexture* Texture, bool bMakeUnique)
@@ -101,11 +114,62 @@ FImGuiTextureHandle FImGuiModule::RegisterTexture(const FName& Name, class UText
 	return FImGuiTextureHandle{ Name, ImGuiInterops::ToImTextureID(Index) };
 }
 
+FImGuiTextureHandle FImGuiModule::CreateDynamicTexture(const FName& Name, int32 Width, int32 Height)
+{
+	const TextureIndex Index = ImGuiModuleManager->GetTextureManager().CreateDynamicTexture(Name, Width, Height);
+	return FImGuiTextureHandle{ Name, ImGuiInterops::ToImTextureID(Index) };
+}
+
+bool FImGuiModule::UpdateTextureRegion(const FImGuiTextureHandle& Handle, const FIntRect& Region, TArrayView<const FColor> Pixels)
+{
+	return Handle.IsValid() && ImGuiModuleManager->GetTextureManager().UpdateTextureRegion(ImGuiInterops::ToTextureIndex(Handle.GetTextureId()),
+		Region, Pixels);
+}
+
+bool FImGuiModule::SetTextureReloadCallback(const FImGuiTextureHandle& Handle, TFunction<void(const FName&)> ReloadCallback)
+{
+	FTextureManager& TextureManager = ImGuiModuleManager->GetTextureManager();
+	const TextureIndex Index = ImGuiInterops::ToTextureIndex(Handle.GetTextureId());
+
+	// Icons share atlas pages, which are pinned.
+	return Handle.IsValid() && TextureManager.GetTextureName(Index) == Handle.GetName()
+		&& TextureManager.SetTextureReloadCallback(Index, MoveTemp(ReloadCallback));
+}
+
+FImGuiTextureHandle FImGuiModule::RegisterIcon(const FName& Name, int32 Width, int32 Height, TArrayView<const FColor> Pixels)
+{
+	FTextureManager::FIconLocation Icon;
+	if (ImGuiModuleManager->GetTextureManager().AddIcon(Name, Width, Height, Pixels, Icon))
+	{
+		return FImGuiTextureHandle{ Name, ImGuiInterops::ToImTextureID(Icon.Index), ImGuiInterops::ToImVec2(Icon.UV0), ImGuiInterops::ToImVec2(Icon.UV1) };
+	}
+
+	if (Width > FTextureManager::MaxIconSize || Height > FTextureManager::MaxIconSize)
+	{
+		// Too large for the atlas, so it gets its own texture.
+		FImGuiTextureHandle Handle = CreateDynamicTexture(Name, Width, Height);
+		if (UpdateTextureRegion(Handle, FIntRect(0, 0, Width, Height), Pixels))
+		{
+			return Handle;
+		}
+		ReleaseTexture(Handle);
+	}
+
+	return FImGuiTextureHandle{};
+}
+
 void FImGuiModule::ReleaseTexture(const FImGuiTextureHandle& Handle)
 {
-	if (Handle.IsValid())
+	FTextureManager& TextureManager = ImGuiModuleManager->GetTextureManager();
+
+	if (Handle.IsValid() && TextureManager.GetTextureName(ImGuiInterops::ToTextureIndex(Handle.GetTextureId())) == Handle.GetName())
+	{
+		TextureManager.ReleaseTextureResources(ImGuiInterops::ToTextureIndex(Handle.GetTextureId()));
+	}
+	else if (!Handle.IsNull())
 	{
-		ImGuiModuleManager->GetTextureManager().ReleaseTextureResources(ImGuiInterops::ToTextureIndex(Handle.GetTextureId()));
+		// Icon handles reference shared atlas pages, so icons are released by name.
+		TextureManager.ReleaseIcon(Handle.GetName());
 	}
 }
 
@@ -117,6 +181,14 @@ void FImGuiModule::RebuildFontAtlas()
 	}
 }
 
+void FImGuiModule::RequestRedraw()
+{
+	if (ImGuiModuleManager)
+	{
+		ImGuiModuleManager->GetContextManager().RequestRedraw();
+	}
+}
+
 void FImGuiModule::StartupModule()
 {
 	// Initialize handles to allow cross-module redirections. Other handles will always look for parents in the active
@@ -369,7 +441,15 @@ FImGuiModuleLoader FImGuiModuleLoader::Instance;
 bool FImGuiTextureHandle::HasValidEntry() const
 {
 	const TextureIndex Index = ImGuiInterops::ToTextureIndex(TextureId);
-	return Index != INDEX_NONE && ImGuiModuleManager && ImGuiModuleManager->GetTextureManager().GetTextureName(Index) == Name;
+	if (Index == INDEX_NONE || !ImGuiModuleManager)
+	{
+		return false;
+	}
+
+	// Icons are valid as long as they are in the page referenced by this handle.
+	FTextureManager& TextureManager = ImGuiModuleManager->GetTextureManager();
+	FTextureManager::FIconLocation Icon;
+	return TextureManager.GetTextureName(Index) == Name || (TextureManager.FindIcon(Name, Icon) && Icon.Index == Index);
 }
 
 
@@ -2,6 +2,7 @@
 
 #include "ImGuiModuleCommands.h"
 
+#include "ImGuiModule.h"
 #include "ImGuiModuleProperties.h"
 #include "Utilities/DebugExecBindings.h"
 
@@ -92,4 +93,7 @@ void FImGuiModuleCommands::SetMouseInputSharingImpl(const TArray<FString>& Args)
 void FImGuiModuleCommands::ToggleDemoImpl()
 {
 	Properties.ToggleDemo();
+
+	// Make sure that idle contexts are updated to show or hide the demo.
+	FImGuiModule::Get().RequestRedraw();
 }
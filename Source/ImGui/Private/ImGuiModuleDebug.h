@@ -3,6 +3,7 @@
 #pragma once
 
 #include <Logging/LogMacros.h>
+#include <Stats/Stats.h>
 
 
 // Module-wide debug symbols and loggers.
@@ -12,5 +13,9 @@
 #define IMGUI_MODULE_DEVELOPER 0
 
 
+// Stats group for module counters (use "stat ImGui" to display them).
+DECLARE_STATS_GROUP(TEXT("ImGui"), STATGROUP_ImGui, STATCAT_Advanced);
+
+
 // Input Handler logger (used also in non-developer mode to raise problems with handler extensions).
 DECLARE_LOG_CATEGORY_EXTERN(LogImGuiInputHandler, Warning, All);
@@ -189,6 +189,9 @@ void FImGuiModuleManager::Tick(float DeltaSeconds)
 {
 	if (IsInGameThread())
 	{
+		// Upload textures queued in previous frames before new ones can be created.
+		TextureManager.Tick();
+
 		// Update context manager to advance all ImGui contexts to the next frame.
 		ContextManager.Tick(DeltaSeconds);
 
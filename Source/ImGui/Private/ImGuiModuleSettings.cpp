@@ -102,6 +102,8 @@ void FImGuiModuleSettings::UpdateSettings()
 		SetUseSoftwareCursor(SettingsObject->bUseSoftwareCursor);
 		SetToggleInputKey(SettingsObject->ToggleInput);
 		SetCanvasSizeInfo(SettingsObject->CanvasSize);
+		SetMaxUpdateRate(SettingsObject->MaxUpdateRate);
+		SetIdleFrameSkipping(SettingsObject->bEnableIdleFrameSkipping, SettingsObject->MaxIdleInterval);
 	}
 }
 
@@ -168,6 +170,21 @@ void FImGuiModuleSettings::SetCanvasSizeInfo(const FImGuiCanvasSizeInfo& CanvasS
 	}
 }
 
+void FImGuiModuleSettings::SetMaxUpdateRate(float Rate)
+{
+	if (MaxUpdateRate != Rate)
+	{
+		MaxUpdateRate = Rate;
+		Properties.SetMaxUpdateRate(Rate);
+	}
+}
+
+void FImGuiModuleSettings::SetIdleFrameSkipping(bool bEnabled, float InMaxIdleInterval)
+{
+	bEnableIdleFrameSkipping = bEnabled;
+	MaxIdleInterval = FMath::Max(InMaxIdleInterval, 0.f);
+}
+
 void FImGuiModuleSettings::SetDPIScaleInfo(const FImGuiDPIScaleInfo& ScaleInfo)
 {
 	DPIScale = ScaleInfo;
@@ -163,6 +163,26 @@ protected:
 	UPROPERTY(EditAnywhere, config, Category = "Canvas Size")
 	FImGuiCanvasSizeInfo CanvasSize;
 
+	// Maximum rate in Hz at which contexts are updated, independently from the game frame rate. On skipped frames,
+	// module delegates are not called, input accumulates until the next update and contexts present the last draw data.
+	// Widgets drawn outside of delegates are discarded in skipped frames. Contexts with active items or input are not
+	// throttled. Zero means that contexts are updated in every frame.
+	// This defines initial behaviour which can be later changed using 'ImGui.MaxUpdateRate' console variable or module
+	// properties interface.
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0, Units = "Hertz"))
+	float MaxUpdateRate = 0.f;
+
+	// If true, contexts skip frames when idle, i.e. when there is no input, no active items and no redraw requests.
+	// Skipped frames present the last draw data and don't broadcast draw delegates, so controls showing live values
+	// should request a redraw (see FImGuiModule::RequestRedraw). Skipped frames are not started, so controls drawn
+	// outside of module delegates (e.g. from an actor tick) are discarded in those frames.
+	UPROPERTY(EditAnywhere, config, Category = "Performance")
+	bool bEnableIdleFrameSkipping = false;
+
+	// Maximum time in seconds for which an idle context can skip frames, before it is updated anyway.
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0, EditCondition = "bEnableIdleFrameSkipping"))
+	float MaxIdleInterval = 1.f;
+
 	static UImGuiSettings* DefaultInstance;
 
 	friend class FImGuiModuleSettings;
@@ -208,6 +228,12 @@ public:
 	// Get the information how to calculate the canvas size.
 	const FImGuiCanvasSizeInfo& GetCanvasSizeInfo() const { return CanvasSize; }
 
+	// Get whether contexts can skip frames while idle.
+	bool IsIdleFrameSkippingEnabled() const { return bEnableIdleFrameSkipping; }
+
+	// Get the maximum time in seconds for which an idle context can skip frames.
+	float GetMaxIdleInterval() const { return MaxIdleInterval; }
+
 	// DPI Scale information.
 	const FImGuiDPIScaleInfo& GetDPIScaleInfo() const { return DPIScale; }
 	virtual void SetDPIScaleInfo(const FImGuiDPIScaleInfo& InDPIScale) override;
@@ -234,6 +260,8 @@ private:
 	void SetUseSoftwareCursor(bool bUse);
 	void SetToggleInputKey(const FImGuiKeyInfo& KeyInfo);
 	void SetCanvasSizeInfo(const FImGuiCanvasSizeInfo& CanvasSizeInfo);
+	void SetMaxUpdateRate(float Rate);
+	void SetIdleFrameSkipping(bool bEnabled, float InMaxIdleInterval);
 
 	FImGuiModuleProperties& Properties;
 	FImGuiModuleCommands& Commands;
@@ -246,4 +274,7 @@ private:
 	bool bShareGamepadInput = false;
 	bool bShareMouseInput = false;
 	bool bUseSoftwareCursor = false;
+	float MaxUpdateRate = 0.f;
+	bool bEnableIdleFrameSkipping = false;
+	float MaxIdleInterval = 1.f;
 };
@@ -4,21 +4,76 @@
 #include "ImGuiModuleManager.h"
 #include "ImGuiContextManager.h"
 #include "ImGuiContextProxy.h"
+#include "NetImGuiBenchmark.h"
 #include "imgui.h"
 #include "NetImgui_Config.h"
 #include "NetImgui_Api.h"
 #include "NetImgui_Network.h"
 #include "NetImguiServer_App.h"
+#include "NetImguiServer_Config.h"
+#include "NetImguiServer_Recording.h"
 #include "NetImguiServer_RemoteClient.h"
 
+#include "Algo/Count.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
 #include "Misc/ScopeRWLock.h"
 #include "Internationalization/Regex.h"
 #include "HAL/PlatformApplicationMisc.h"
 
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiNetControl, Log, All);
+
 static TAnsiStringBuilder<256> gUserSettingFolderPath;
 
+// Context index of the connection whose textures are being created. Remote clients reuse the same texture ids, so
+// names of their textures are prefixed with it to keep connections from replacing each other's textures.
+static int32 gTextureNamespace = INDEX_NONE;
+
+// Whether textures being created can be requested again from the client, which is not possible during replays.
+static bool gTexturesResendable = false;
+
+// Maximum time without exchanging data with the client, after which we send a ping anyway.
+static constexpr uint32 NetImguiKeepAliveMs = 100;
+
+// Time in seconds after which textures that are still missing can be requested from the client again.
+static constexpr double NetImguiTexturesResendTimeout = 2.0;
+
+// Extension of NetImgui recordings, which are saved to and loaded from the project's Saved/NetImgui folder by default.
+static const TCHAR* NetImguiRecordingExtension = TEXT(".nirec");
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> NetImguiEntropyCompression(TEXT("ImGui.NetImgui.EntropyCompression"), 0,
+		TEXT("Let the remote game server entropy code delta compressed draw data, using an engine compression format.\n")
+		TEXT("Reduces bandwidth on slow connections, at the cost of some CPU time. Applied on the next connection.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> NetImguiMaxBytesPerSecond(TEXT("ImGui.NetImgui.MaxBytesPerSecond"), 0,
+		TEXT("Bandwidth budget for draw data sent to the NetImgui server. Frames are skipped instead of queued in the connection ")
+		TEXT("to stay under it, and compression is enabled while throttled.\n")
+		TEXT("0: unlimited (default)"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> NetImguiMaxLatencyMs(TEXT("ImGui.NetImgui.MaxLatencyMs"), 0,
+		TEXT("Time the NetImgui server can take to acknowledge a frame, before the frame rate is lowered to wait on each ")
+		TEXT("acknowledge. Prevents input latency from growing on slow connections.\n")
+		TEXT("0: unlimited (default)"),
+		ECVF_Default);
+}
+
+// Forward frame pacing settings to the NetImgui client.
+static void ApplyNetImguiFramePacing(IConsoleVariable* = nullptr)
+{
+	NetImgui::SetFramePacing(static_cast<uint32_t>(FMath::Max(CVars::NetImguiMaxBytesPerSecond.GetValueOnAnyThread(), 0)),
+		static_cast<uint32_t>(FMath::Max(CVars::NetImguiMaxLatencyMs.GetValueOnAnyThread(), 0)));
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // FImguiServerState
 
@@ -41,41 +96,128 @@ enum class EImguiConnectionState
 class FImguiClientConnectionRunnable : public FRunnable
 {
 public:
+	FImguiClientConnectionRunnable();
+	virtual ~FImguiClientConnectionRunnable();
+
 	virtual uint32 Run() override;
 	virtual void Stop() override;
 
+	// Wake the connection thread to send pending data without waiting for the client.
+	void Wake();
+
 	FImguiServerState* State;
 	TArray<char> Hostname;
 	int32 Port = 0;
 	bool bExitRequested = false;
+
+private:
+
+	void RunConnection();
+	void RunReplay();
+	void WaitForActivity();
+
+	// Interrupts waits for incoming data on the client socket. Replay has no socket and waits on the event instead.
+	NetImgui::Internal::Network::WakeInfo* SocketWake = nullptr;
+	FEventRef WakeEvent;
 };
 
 struct FImguiServerState
 {
+	FImguiServerState(int32 InContextIndex) : ContextIndex(InContextIndex) {}
+	~FImguiServerState();
+
 	bool IsConnected();
 	bool IsConnectionPending();
+	bool IsReplaying();
+	bool IsRecording();
 	void Connect(const char* Hostname, int32 Port);
+	bool Replay(const FString& Filename);
 	void Disconnect();
+	bool StartRecording(const FString& Filename);
+	void StopRecording();
 	void CaptureInput();
-	TUniquePtr<ImDrawData> GetDrawData();
+	void DrawStats();
+	void DrawReplayControls();
+	void RequestDeltaBenchmark(int32 FrameCount, int32 Iterations);
+	void UpdateDeltaBenchmark();
+	void RequestTexturesResend(const FName& TextureName);
+	void UpdateTexturesResend();
+	TSharedPtr<const FImGuiRemoteDrawData, ESPMode::ThreadSafe> GetDrawData();
+
+	// Context in which draw data of this connection are displayed.
+	const int32 ContextIndex;
 
 	// worker thread data
 	NetImgui::Internal::Network::SocketInfo* ClientSocket = nullptr;
 	FImguiClientConnectionRunnable ClientRunnable;
 	FRunnableThread* ClientConnectionThread = nullptr;
 
-	// Shared data
+	// Shared data (lock guards lifetime of the client, which is created and released by the worker thread)
 	FRWLock NetClientLock;
 	TUniquePtr<NetImguiServer::RemoteClient::Client> NetClient;
 	std::atomic<EImguiConnectionState> ConnectionState = EImguiConnectionState::None;
 
+	// Replay data (player is opened by the main thread before starting the worker thread, which releases it)
+	TUniquePtr<NetImguiServer::Recording::Player> ReplayPlayer;
+	std::atomic<int32> ReplaySeekKeyframe = INDEX_NONE;
+	std::atomic<bool> bReplayPaused = false;
+	std::atomic<uint64> ReplayTimeUs = 0;
+
 	// main thread data
-	TArray<ImDrawList> TempDrawLists;
+	TSharedPtr<const FImGuiRemoteDrawData, ESPMode::ThreadSafe> DrawDataSnapshot;
+	int32 DeltaBenchmarkIterations = 0;
 	FString Clipboard;
 	TArray<UTF8CHAR> Utf8Clipboard;
+	FString RecordingFilename;
+	FString ReplayFilename;
+	uint64 ReplayDurationUs = 0;
+	int32 ReplayKeyframeCount = 0;
+	int32 ReplayKeyframe = 0;
+
+	// Evicted textures waiting for the outstanding resend request and the time of that request. Client resends all
+	// textures, so we don't request them again until they arrive or the request times out.
+	TSet<FName> TexturesResendNames;
+	double TexturesResendTime = 0.0;
+
+private:
+
+	bool BeginConnection();
 };
 
+FImguiClientConnectionRunnable::FImguiClientConnectionRunnable()
+	: SocketWake(NetImgui::Internal::Network::WakeCreate())
+{
+}
+
+FImguiClientConnectionRunnable::~FImguiClientConnectionRunnable()
+{
+	NetImgui::Internal::Network::WakeDestroy(SocketWake);
+}
+
 uint32 FImguiClientConnectionRunnable::Run()
+{
+	if (State->ReplayPlayer)
+	{
+		RunReplay();
+	}
+	else
+	{
+		RunConnection();
+	}
+
+	// Disconnect was requested at some point
+	NetImgui::Internal::Network::Disconnect(State->ClientSocket);
+	State->ClientSocket = nullptr;
+	State->ReplayPlayer = nullptr;
+	State->ConnectionState = EImguiConnectionState::None;
+
+	auto Lock = FWriteScopeLock(State->NetClientLock);
+	State->NetClient = nullptr;
+
+	return 0;
+}
+
+void FImguiClientConnectionRunnable::RunConnection()
 {
 	State->ClientSocket = NetImgui::Internal::Network::Connect(Hostname.GetData(), Port);
 
@@ -117,7 +259,10 @@ uint32 FImguiClientConnectionRunnable::Run()
 
 					NetImguiServer::Network::Communications_UpdateClientStats(*State->NetClient);
 
-					FPlatformProcess::Sleep(1.0f/30.0f);
+					if (bConnected)
+					{
+						WaitForActivity();
+					}
 				}
 				else
 				{
@@ -126,21 +271,103 @@ uint32 FImguiClientConnectionRunnable::Run()
 			}
 		}
 	}
+}
 
-	// Disconnect was requested at some point
-	NetImgui::Internal::Network::Disconnect(State->ClientSocket);
-	State->ClientSocket = nullptr;
-	State->ConnectionState = EImguiConnectionState::None;
+void FImguiClientConnectionRunnable::RunReplay()
+{
+	NetImguiServer::Recording::Player& Player = *State->ReplayPlayer;
 
-	auto Lock = FWriteScopeLock(State->NetClientLock);
-	State->NetClient = nullptr;
+	{
+		auto Lock = FWriteScopeLock(State->NetClientLock);
 
-	return 0;
+		State->NetClient = MakeUnique<NetImguiServer::RemoteClient::Client>();
+		State->NetClient->Initialize();
+		State->NetClient->mbIsConnected = true;
+	}
+
+	auto ExpectedState = EImguiConnectionState::Pending;
+	if (State->ConnectionState.compare_exchange_strong(ExpectedState, EImguiConnectionState::Connected) == false)
+	{
+		return;
+	}
+
+	// Commands are sent to the client when the playback time reaches the time they were recorded at. Playback time
+	// advances in real time from the last seek point and is held while paused.
+	constexpr uint64 KeepAliveUs = NetImguiKeepAliveMs * 1000ull;
+	int32 SeekKeyframe = 0;
+	uint64 SeekTimeUs = 0;
+	uint64 TimeUs = 0;
+	double SeekTime = 0.0;
+	bool bValid = true;
+
+	while (bValid && !bExitRequested && State->ConnectionState != EImguiConnectionState::Disconnecting)
+	{
+		if (SeekKeyframe == INDEX_NONE)
+		{
+			SeekKeyframe = State->ReplaySeekKeyframe.exchange(INDEX_NONE);
+		}
+
+		if (SeekKeyframe != INDEX_NONE)
+		{
+			bValid = Player.Seek(*State->NetClient, static_cast<uint32>(SeekKeyframe));
+			SeekTimeUs = TimeUs = Player.GetKeyframeTimeUs(static_cast<uint32>(SeekKeyframe));
+			SeekTime = FPlatformTime::Seconds();
+			SeekKeyframe = INDEX_NONE;
+		}
+
+		const bool bPaused = State->bReplayPaused;
+		if (bPaused)
+		{
+			SeekTimeUs = TimeUs;
+			SeekTime = FPlatformTime::Seconds();
+		}
+		else
+		{
+			TimeUs = SeekTimeUs + static_cast<uint64>((FPlatformTime::Seconds() - SeekTime) * 1000000.0);
+			if (bValid && !Player.Update(*State->NetClient, TimeUs))
+			{
+				// Loop back to the start of the recording, after showing the last frame for a moment.
+				SeekKeyframe = 0;
+			}
+		}
+		State->ReplayTimeUs = TimeUs;
+
+		const uint64 NextTimeUs = (bPaused || SeekKeyframe != INDEX_NONE) ? TimeUs + KeepAliveUs : Player.GetNextTimeUs();
+		const uint64 WaitUs = NextTimeUs > TimeUs ? FMath::Min(NextTimeUs - TimeUs, KeepAliveUs) : 0;
+		WakeEvent->Wait(FTimespan::FromMicroseconds(static_cast<double>(WaitUs)));
+	}
 }
 
 void FImguiClientConnectionRunnable::Stop()
 {
 	bExitRequested = true;
+	Wake();
+}
+
+void FImguiClientConnectionRunnable::Wake()
+{
+	NetImgui::Internal::Network::WakeSignal(SocketWake);
+	WakeEvent->Trigger();
+}
+
+void FImguiClientConnectionRunnable::WaitForActivity()
+{
+	// Exchange data as soon as the client sends a frame or when the game thread queues input (wake interrupts the
+	// socket wait). Otherwise, exchange a keep-alive ping after the full interval.
+	if (!bExitRequested)
+	{
+		NetImgui::Internal::Network::DataReceiveWait(State->ClientSocket, SocketWake, NetImguiKeepAliveMs);
+	}
+}
+
+FImguiServerState::~FImguiServerState()
+{
+	if (ClientConnectionThread)
+	{
+		// Stops the runnable and waits for the connection to close.
+		ClientConnectionThread->Kill(true);
+		delete ClientConnectionThread;
+	}
 }
 
 bool FImguiServerState::IsConnected()
@@ -153,7 +380,22 @@ bool FImguiServerState::IsConnectionPending()
 	return ConnectionState == EImguiConnectionState::Pending;
 }
 
-void FImguiServerState::Connect(const char* Hostname, int32 Port)
+bool FImguiServerState::IsReplaying()
+{
+	return ConnectionState != EImguiConnectionState::None && !ReplayFilename.IsEmpty();
+}
+
+bool FImguiServerState::IsRecording()
+{
+	if (IsConnected())
+	{
+		auto Lock = FReadScopeLock(NetClientLock);
+		return NetClient->mRecorder.IsRecording();
+	}
+	return false;
+}
+
+bool FImguiServerState::BeginConnection()
 {
 	if (ConnectionState == EImguiConnectionState::None)
 	{
@@ -169,13 +411,56 @@ void FImguiServerState::Connect(const char* Hostname, int32 Port)
 			}
 
 			ClientRunnable.State = this;
-			ClientRunnable.Hostname.SetNum(FCStringAnsi::Strlen(Hostname) + 1, EAllowShrinking::Yes);
-			FCStringAnsi::Strcpy(ClientRunnable.Hostname.GetData(), ClientRunnable.Hostname.Num(), Hostname);
-			ClientRunnable.Port = Port;
 			ClientRunnable.bExitRequested = false;
-			ClientConnectionThread = FRunnableThread::Create(&ClientRunnable, TEXT("NetimguiServerThread"));
+			return true;
 		}
 	}
+
+	return false;
+}
+
+void FImguiServerState::Connect(const char* Hostname, int32 Port)
+{
+	if (BeginConnection())
+	{
+		ReplayFilename.Reset();
+		TexturesResendNames.Reset();
+		ClientRunnable.Hostname.SetNum(FCStringAnsi::Strlen(Hostname) + 1, EAllowShrinking::Yes);
+		FCStringAnsi::Strcpy(ClientRunnable.Hostname.GetData(), ClientRunnable.Hostname.Num(), Hostname);
+		ClientRunnable.Port = Port;
+		NetImguiServer::Config::Server::sEntropyCompressionEnable = CVars::NetImguiEntropyCompression.GetValueOnGameThread() > 0;
+		ClientConnectionThread = FRunnableThread::Create(&ClientRunnable, *FString::Printf(TEXT("NetimguiServerThread_%d"), ContextIndex));
+	}
+}
+
+bool FImguiServerState::Replay(const FString& Filename)
+{
+	TUniquePtr<NetImguiServer::Recording::Player> Player = MakeUnique<NetImguiServer::Recording::Player>();
+	if (!Player->Open(TCHAR_TO_ANSI(*Filename)))
+	{
+		UE_LOG(LogImGuiNetControl, Warning, TEXT("Failed to open NetImgui recording '%s' (missing, corrupted or made by another version)."), *Filename);
+		return false;
+	}
+
+	if (!BeginConnection())
+	{
+		UE_LOG(LogImGuiNetControl, Warning, TEXT("Context %d is already used by a NetImgui connection."), ContextIndex);
+		return false;
+	}
+
+	ReplayFilename = Filename;
+	ReplayDurationUs = Player->GetDurationUs();
+	ReplayKeyframeCount = static_cast<int32>(Player->GetKeyframeCount());
+	ReplayKeyframe = 0;
+	ReplaySeekKeyframe = INDEX_NONE;
+	bReplayPaused = false;
+	ReplayTimeUs = 0;
+	ReplayPlayer = MoveTemp(Player);
+	ClientConnectionThread = FRunnableThread::Create(&ClientRunnable, *FString::Printf(TEXT("NetimguiReplayThread_%d"), ContextIndex));
+
+	UE_LOG(LogImGuiNetControl, Log, TEXT("Replaying NetImgui recording '%s' in context %d (%.1f s, %d keyframes)."), *Filename, ContextIndex,
+		ReplayDurationUs / 1000000.0, ReplayKeyframeCount);
+	return true;
 }
 
 void FImguiServerState::Disconnect()
@@ -185,6 +470,46 @@ void FImguiServerState::Disconnect()
 		ConnectionState = EImguiConnectionState::Disconnecting;
 
 		check(ClientConnectionThread);
+		ClientRunnable.Wake();
+	}
+}
+
+bool FImguiServerState::StartRecording(const FString& Filename)
+{
+	if (!IsConnected() || IsReplaying())
+	{
+		return false;
+	}
+
+	auto Lock = FReadScopeLock(NetClientLock);
+
+	if (NetClient->mRecorder.IsRecording())
+	{
+		return false;
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+	if (!NetClient->StartRecording(TCHAR_TO_ANSI(*Filename)))
+	{
+		UE_LOG(LogImGuiNetControl, Warning, TEXT("Failed to create NetImgui recording '%s'."), *Filename);
+		return false;
+	}
+
+	RecordingFilename = Filename;
+	UE_LOG(LogImGuiNetControl, Log, TEXT("Recording NetImgui context %d to '%s'."), ContextIndex, *Filename);
+	return true;
+}
+
+void FImguiServerState::StopRecording()
+{
+	if (IsRecording())
+	{
+		auto Lock = FReadScopeLock(NetClientLock);
+
+		const uint64 FileSize = NetClient->mRecorder.GetFileSize();
+		const uint32 KeyframeCount = NetClient->mRecorder.GetKeyframeCount();
+		NetClient->StopRecording();
+		UE_LOG(LogImGuiNetControl, Log, TEXT("Saved NetImgui recording '%s' (%llu KB, %u keyframes)."), *RecordingFilename, FileSize / 1024, KeyframeCount);
 	}
 }
 
@@ -223,55 +548,227 @@ void FImguiServerState::CaptureInput()
 
 			NetImgui::Internal::netImguiDeleteSafe(pClientIncomingClipboard);
 		}
+
+		// Send captured input without waiting for the next client frame.
+		ClientRunnable.Wake();
 	}
 }
 
-TUniquePtr<ImDrawData> FImguiServerState::GetDrawData()
+void FImguiServerState::DrawStats()
 {
 	if (IsConnected())
 	{
-		auto Lock = FWriteScopeLock(NetClientLock);
-		NetClient->ProcessPendingTextures();
+		auto Lock = FReadScopeLock(NetClientLock);
+
+		ImGui::Text("Data: (Rx) %d KB/s (Tx) %d KB/s", NetClient->mStatsRcvdBps / 1024, NetClient->mStatsSentBps / 1024);
+		ImGui::Text("Compression: %.1fx (Entropy) %.2fx, Enc %d us, Dec %d us", NetClient->mStatsCompressionRatio,
+			NetClient->mStatsEntropyRatio, NetClient->mStatsEntropyEncodeUs, NetClient->mStatsEntropyDecodeUs);
+		ImGui::Text("Draw Groups: %d (New) %d (Removed) %d", NetClient->mStatsDrawGroups, NetClient->mStatsDrawGroupsNew,
+			NetClient->mStatsDrawGroupsDel);
+		if (NetClient->mRecorder.IsRecording())
+		{
+			ImGui::Text("Recording: %s (%llu KB, %u keyframes)", TCHAR_TO_UTF8(*FPaths::GetCleanFilename(RecordingFilename)),
+				NetClient->mRecorder.GetFileSize() / 1024, NetClient->mRecorder.GetKeyframeCount());
+		}
+	}
+}
 
-		// deep copy the data since the internal arrays get transferred to the context proxy and we may
-		// need to reuse the same data if we don't get another net update before the next frame
-		TUniquePtr<ImDrawData> DrawData = MakeUnique<ImDrawData>();
-		ImDrawData* ServerData = NetClient->GetImguiDrawData(nullptr);
-		if (ServerData)
+void FImguiServerState::DrawReplayControls()
+{
+	ImGui::Text("Replay: %s", TCHAR_TO_UTF8(*FPaths::GetCleanFilename(ReplayFilename)));
+	if (!IsConnected())
+	{
+		ImGui::Text(IsConnectionPending() ? "Starting..." : "Stopping...");
+		return;
+	}
+
+	ImGui::Text("Time: %.1f / %.1f s", ReplayTimeUs / 1000000.0, ReplayDurationUs / 1000000.0);
+
+	const bool bPaused = bReplayPaused;
+	if (ImGui::Button(bPaused ? "Resume" : "Pause"))
+	{
+		bReplayPaused = !bPaused;
+		ClientRunnable.Wake();
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Stop"))
+	{
+		Disconnect();
+	}
+
+	// Recordings can only be decoded from keyframes, so these are the only seek points.
+	if (ImGui::SliderInt("Keyframe", &ReplayKeyframe, 0, FMath::Max(ReplayKeyframeCount - 1, 0)))
+	{
+		ReplaySeekKeyframe = ReplayKeyframe;
+		ClientRunnable.Wake();
+	}
+
+	DrawStats();
+}
+
+void FImguiServerState::RequestDeltaBenchmark(int32 FrameCount, int32 Iterations)
+{
+	if (!IsConnected())
+	{
+		UE_LOG(LogImGuiNetControl, Warning, TEXT("Delta compression benchmark needs a connected NetImgui client."));
+		return;
+	}
+
+	auto Lock = FReadScopeLock(NetClientLock);
+
+	if (NetClient->mFrameCaptureRequested != 0)
+	{
+		UE_LOG(LogImGuiNetControl, Warning, TEXT("Delta compression benchmark is already capturing frames."));
+		return;
+	}
+
+	// Frames are captured by the connection thread as they arrive and benchmarked on the main thread once all are available.
+	DeltaBenchmarkIterations = FMath::Max(Iterations, 1);
+	NetClient->mFrameCaptureRequested = static_cast<uint32>(FMath::Clamp(FrameCount, 2, static_cast<int32>(UE_ARRAY_COUNT(NetClient->mpFrameCaptures))));
+	UE_LOG(LogImGuiNetControl, Log, TEXT("Delta compression benchmark capturing %u frames in context %d."), NetClient->mFrameCaptureRequested.load(),
+		ContextIndex);
+}
+
+void FImguiServerState::UpdateDeltaBenchmark()
+{
+	// Called with the client lock.
+	const uint32 FrameCount = NetClient->mFrameCaptureCount;
+	if (FrameCount == 0 || FrameCount != NetClient->mFrameCaptureRequested)
+	{
+		return;
+	}
+
+	NetImgui::Internal::DeltaBenchmarkResult Result;
+	uint32 NumInvalidPairs = 0;
+	for (uint32 Index = 1; Index < FrameCount; Index++)
+	{
+		if (!NetImgui::Internal::BenchmarkDeltaCompression(NetClient->mpFrameCaptures[Index - 1], NetClient->mpFrameCaptures[Index],
+			DeltaBenchmarkIterations, Result))
+		{
+			NumInvalidPairs++;
+		}
+	}
+	NetClient->ReleaseFrameCaptures();
+
+	const double NumRuns = static_cast<double>(FrameCount - 1) * DeltaBenchmarkIterations;
+	UE_LOG(LogImGuiNetControl, Log, TEXT("Delta compression benchmark: %u frame pairs x %d iterations, %.1f KB per frame packed to %.1f KB."),
+		FrameCount - 1, DeltaBenchmarkIterations, Result.mDataSize / 1024.0 / (FrameCount - 1), Result.mPackedSize / 1024.0 / (FrameCount - 1));
+	UE_LOG(LogImGuiNetControl, Log, TEXT("  Compress: %.1f us (reference %.1f us), Decompress: %.1f us (reference %.1f us) per frame."),
+		Result.mCompressUs / NumRuns, Result.mCompressReferenceUs / NumRuns, Result.mDecompressUs / NumRuns, Result.mDecompressReferenceUs / NumRuns);
+	if (NumInvalidPairs > 0)
+	{
+		UE_LOG(LogImGuiNetControl, Error, TEXT("Delta compression benchmark: %u frame pairs produced data different from the reference implementation."),
+			NumInvalidPairs);
+	}
+}
+
+void FImguiServerState::RequestTexturesResend(const FName& TextureName)
+{
+	if (IsConnected() && !IsReplaying())
+	{
+		// Evicted textures are requested every time they are drawn, but one request brings all of them.
+		UpdateTexturesResend();
+		const bool bIsResendOutstanding = TexturesResendNames.Num() > 0;
+		TexturesResendNames.Add(TextureName);
+		if (bIsResendOutstanding)
+		{
+			return;
+		}
+
+		auto Lock = FReadScopeLock(NetClientLock);
+
+		// Client sends all its textures again, which re-creates the evicted ones under the same names.
+		if (NetClient)
+		{
+			NetClient->mbTexturesResendPending = true;
+			ClientRunnable.Wake();
+			TexturesResendTime = FPlatformTime::Seconds();
+		}
+		else
+		{
+			TexturesResendNames.Reset();
+		}
+	}
+}
+
+void FImguiServerState::UpdateTexturesResend()
+{
+	if (TexturesResendNames.Num() > 0)
+	{
+		// Textures that are lost (e.g. released by the client) would block requests, so they are only waited for
+		// until the timeout.
+		if (FPlatformTime::Seconds() - TexturesResendTime > NetImguiTexturesResendTimeout)
 		{
-			TempDrawLists.Reset();
-			for (ImDrawList* DrawList : ServerData->CmdLists)
+			TexturesResendNames.Reset();
+			return;
+		}
+
+		// Textures arrive as they are re-created under the same names.
+		const FTextureManager& TextureManager = FImGuiModuleManager::Get()->GetTextureManager();
+		for (auto It = TexturesResendNames.CreateIterator(); It; ++It)
+		{
+			if (!TextureManager.IsTextureEvicted(TextureManager.FindTextureIndex(*It)))
 			{
-				TempDrawLists.Emplace(*DrawList);
+				It.RemoveCurrent();
 			}
+		}
+	}
+}
+
+TSharedPtr<const FImGuiRemoteDrawData, ESPMode::ThreadSafe> FImguiServerState::GetDrawData()
+{
+	if (IsConnected())
+	{
+		// Draw data and textures of the client are only accessed on the main thread, so we only need to make sure that
+		// the client is not released while we use it.
+		auto Lock = FReadScopeLock(NetClientLock);
 
-			*DrawData = *ServerData;
-			DrawData->CmdLists.clear();
-			for (ImDrawList& DrawList : TempDrawLists)
+		// Texture changes invalidate the current draw data, since it may reference released textures.
+		{
+			TGuardValue<int32> TextureNamespace(gTextureNamespace, ContextIndex);
+			TGuardValue<bool> TexturesResendable(gTexturesResendable, !IsReplaying());
+			NetClient->ProcessPendingTextures();
+		}
+		UpdateTexturesResend();
+		UpdateDeltaBenchmark();
+		if (NetClient->mpImguiDrawData == nullptr)
+		{
+			DrawDataSnapshot.Reset();
+		}
+
+		// Take a snapshot only when a new frame arrives. Draw lists are moved to the snapshot, which is immutable, so it
+		// can be shared with published frames until replaced.
+		NetImguiServer::RemoteClient::NetImguiImDrawData* PreviousData = NetClient->mpImguiDrawData;
+		ImDrawData* ServerData = NetClient->GetImguiDrawData(nullptr);
+		if (ServerData && ServerData != PreviousData)
+		{
+			TSharedRef<FImGuiRemoteDrawData, ESPMode::ThreadSafe> Snapshot = MakeShared<FImGuiRemoteDrawData, ESPMode::ThreadSafe>();
+			Snapshot->DrawLists.SetNum(ServerData->CmdListsCount);
+			for (int Index = 0; Index < ServerData->CmdListsCount; Index++)
 			{
-				DrawData->CmdLists.push_back(&DrawList);
+				Snapshot->DrawLists[Index].TransferDrawData(*ServerData->CmdLists[Index]);
 			}
 
-			return DrawData;
+			DrawDataSnapshot = Snapshot;
 		}
+
+		return DrawDataSnapshot;
 	}
 
+	DrawDataSnapshot.Reset();
 	return nullptr;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // FImGuiNetControl
 
-// Defined in the .cpp so this function can
+// Defined in the .cpp, where server state is a complete type.
 FImGuiNetControl::~FImGuiNetControl()
 {
-	delete ServerState;
 }
 
 void FImGuiNetControl::Startup(FImGuiContextManager* InContextManager)
 {
-	ServerState = new FImguiServerState();
-
 	if (!FParse::Value(FCommandLine::Get(), TEXT("NetImguiClientPort="), Port))
 	{
 		Port = NetImgui::kDefaultClientPort;
@@ -279,40 +776,92 @@ void FImGuiNetControl::Startup(FImGuiContextManager* InContextManager)
 
 	ContextManager = InContextManager;
 
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(TEXT("ImGui.NetImgui.BenchmarkDeltaCompression"),
+		TEXT("Capture frames from the connected NetImgui clients and benchmark their delta compression against the reference ")
+		TEXT("implementation. Results are logged once all frames are captured.\n")
+		TEXT("Arguments: [FrameCount=16] [Iterations=100]"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FImGuiNetControl::BenchmarkDeltaCompression)));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(TEXT("ImGui.NetImgui.BenchmarkPipeline"),
+		TEXT("Benchmark every stage of the NetImgui pipeline in-process, without connection or rendering, and save the results as JSON. ")
+		TEXT("Frames are generated by a local ImGui context, or read from a recording made with ImGui.NetImgui.StartRecording.\n")
+		TEXT("Arguments: [Recording=Synthetic] [Iterations=10] [FrameCount=120] [Output=Saved/NetImgui/PipelineBenchmark_<Date>.json]"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FImGuiNetControl::BenchmarkPipeline)));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(TEXT("ImGui.NetImgui.StartRecording"),
+		TEXT("Record the draw frames received from the connected NetImgui clients, to be replayed later with ImGui.NetImgui.Replay. ")
+		TEXT("Relative filenames are saved in the Saved/NetImgui folder, with the context index appended when several clients are connected.\n")
+		TEXT("Arguments: [Filename=NetImgui_<Context>_<Date>.nirec]"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FImGuiNetControl::StartRecording)));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(TEXT("ImGui.NetImgui.StopRecording"),
+		TEXT("Stop all NetImgui recordings."),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FImGuiNetControl::StopRecording)));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(TEXT("ImGui.NetImgui.Replay"),
+		TEXT("Replay a NetImgui recording without a game server. Relative filenames are loaded from the Saved/NetImgui folder.\n")
+		TEXT("Arguments: <Filename> [ContextIndex=<First game world>]"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FImGuiNetControl::Replay)));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(TEXT("ImGui.NetImgui.StopReplay"),
+		TEXT("Stop all NetImgui replays."),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FImGuiNetControl::StopReplay)));
+
 	NetImgui::Startup();
+
+	ApplyNetImguiFramePacing();
+	CVars::NetImguiMaxBytesPerSecond.AsVariable()->SetOnChangedCallback(FConsoleVariableDelegate::CreateStatic(&ApplyNetImguiFramePacing));
+	CVars::NetImguiMaxLatencyMs.AsVariable()->SetOnChangedCallback(FConsoleVariableDelegate::CreateStatic(&ApplyNetImguiFramePacing));
 }
 
 void FImGuiNetControl::Shutdown()
 {
+	for (IConsoleObject* ConsoleCommand : ConsoleCommands)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(ConsoleCommand);
+	}
+	ConsoleCommands.Empty();
+
+	// Closes all connections and waits for their threads.
+	ServerStates.Empty();
+	GameServerAddresses.Empty();
+
 	NetImgui::Shutdown();
 }
 
 bool FImGuiNetControl::OnWorldStartup(int32 InContextIndex, UWorld* World)
 {
-	ContextIndex = InContextIndex;
-
 	if (World->GetNetMode() == NM_Client)
 	{
-		// Let the client decide when they want to connect - this happens in ServerMenu()
-		if (World->WorldType == EWorldType::Game)
+		// Let the client decide when they want to connect - this happens in ServerMenu(). Address is kept once found, so
+		// it can be edited in the menu.
+		if (!GameServerAddresses.Contains(InContextIndex))
 		{
-			// Logic adapeted from UGameInstance::StartGameInstance(), where the URL is parsed
-			// from the commandline
-			const TCHAR* Cmd = FCommandLine::Get();
-			FString Hostname;
-			if (FParse::Token(Cmd, Hostname, 0) && **Hostname != '-')
+			FServerAddress Address;
+			Address.Port = static_cast<int32>(Port);
+
+			if (World->WorldType == EWorldType::Game)
 			{
-				int32 PortStartIndex = 0;
-				if (Hostname.FindLastChar(':', PortStartIndex))
+				// Logic adapeted from UGameInstance::StartGameInstance(), where the URL is parsed
+				// from the commandline
+				const TCHAR* Cmd = FCommandLine::Get();
+				FString Hostname;
+				if (FParse::Token(Cmd, Hostname, 0) && **Hostname != '-')
 				{
-					Hostname.LeftInline(PortStartIndex);
+					int32 PortStartIndex = 0;
+					if (Hostname.FindLastChar(':', PortStartIndex))
+					{
+						Hostname.LeftInline(PortStartIndex);
+					}
+					Address.Hostname = MoveTemp(Hostname);
 				}
-				GameServerHostname = MoveTemp(Hostname);
 			}
-		}
-		else
-		{
-			GameServerHostname = TEXT("localhost");
+			else
+			{
+				Address.Hostname = TEXT("localhost");
+			}
+
+			GameServerAddresses.Add(InContextIndex, MoveTemp(Address));
 		}
 	}
 	else
@@ -335,26 +884,18 @@ bool FImGuiNetControl::IsConnected()
 
 bool FImGuiNetControl::IsConnected(int32 InContextIndex)
 {
-	if (ContextIndex && *ContextIndex == InContextIndex)
-	{
-		return IsConnected();
-	}
-
-	return false;
+	const TUniquePtr<FImguiServerState>* ServerState = ServerStates.Find(InContextIndex);
+	return ServerState && (*ServerState)->IsConnected();
 }
 
 void FImGuiNetControl::Disconnect(int32 InContextIndex)
 {
-	if (ContextIndex && *ContextIndex == InContextIndex)
+	if (TUniquePtr<FImguiServerState>* ServerState = ServerStates.Find(InContextIndex))
 	{
-		ContextIndex.Reset();
-		if (NetImgui::IsConnected() || NetImgui::IsConnectionPending())
-		{
-			NetImgui::Disconnect();
-		}
+		(*ServerState)->Disconnect();
 	}
 
-	GameServerHostname.Reset();
+	GameServerAddresses.Remove(InContextIndex);
 }
 
 bool FImGuiNetControl::ServerMenu(UWorld* World)
@@ -372,50 +913,93 @@ bool FImGuiNetControl::ServerMenu(UWorld* World)
 		}
 	}
 
+	int32 WorldContextIndex;
+	ContextManager->GetWorldContextProxy(*World, WorldContextIndex);
+
+	// Replays don't need a game server, so they are controlled from any world.
+	TUniquePtr<FImguiServerState>* ReplayState = ServerStates.Find(WorldContextIndex);
+	if (ReplayState && (*ReplayState)->IsReplaying())
+	{
+		(*ReplayState)->DrawReplayControls();
+		return true;
+	}
+
 	if (bIsNetImguiServer)
 	{
-		if (GameServerHostname.IsSet())
+		FServerAddress* Address = GameServerAddresses.Find(WorldContextIndex);
+		if (Address && !Address->Hostname.IsEmpty())
 		{
-			ImGui::Text("Game Server: %s:%d", TCHAR_TO_ANSI(**GameServerHostname), Port);
-			EImguiConnectionState ServerConnection = ServerState->ConnectionState;
+			const int32 NumConnections = GetNumConnections();
+
+			TUniquePtr<FImguiServerState>* ServerState = ServerStates.Find(WorldContextIndex);
+			EImguiConnectionState ServerConnection = ServerState ? (*ServerState)->ConnectionState.load() : EImguiConnectionState::None;
 			switch (ServerConnection)
 			{
 				case EImguiConnectionState::None:
 				{
-					ContextIndex.Reset();
+					// Port can be changed to connect to one of several game servers running on the same host.
+					ImGui::Text("Game Server: %s", TCHAR_TO_ANSI(*Address->Hostname));
+					ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.f);
+					ImGui::InputInt("Port", &Address->Port, 0);
+					Address->Port = FMath::Clamp(Address->Port, 1, 65535);
 
-					if (ImGui::Button("Connect"))
+					if (NumConnections >= MaxServerConnections)
 					{
-						ServerState->Connect(TCHAR_TO_ANSI(**GameServerHostname), Port);
-
-						int32 FoundContextIndex;
-						ContextManager->GetWorldContextProxy(*World, FoundContextIndex);
-						ContextIndex = FoundContextIndex;
+						ImGui::Text("All %d connections are in use", MaxServerConnections);
+					}
+					else if (ImGui::Button("Connect"))
+					{
+						if (ServerState == nullptr)
+						{
+							ServerState = &ServerStates.Add(WorldContextIndex, MakeUnique<FImguiServerState>(WorldContextIndex));
+						}
+						(*ServerState)->Connect(TCHAR_TO_ANSI(*Address->Hostname), Address->Port);
 					}
 					break;
 				}
 
 				case EImguiConnectionState::Pending:
 				{
+					ImGui::Text("Game Server: %s:%d", TCHAR_TO_ANSI(*Address->Hostname), Address->Port);
 					ImGui::Text("Connecting...");
 					break;
 				}
 
 				case EImguiConnectionState::Disconnecting:
 				{
+					ImGui::Text("Game Server: %s:%d", TCHAR_TO_ANSI(*Address->Hostname), Address->Port);
 					ImGui::Text("Disconnecting...");
 					break;
 				}
 
 				case EImguiConnectionState::Connected:
 				{
+					ImGui::Text("Game Server: %s:%d", TCHAR_TO_ANSI(*Address->Hostname), Address->Port);
 					if (ImGui::Button("Disconnect"))
 					{
-						ServerState->Disconnect();
+						(*ServerState)->Disconnect();
+					}
+					ImGui::SameLine();
+					if ((*ServerState)->IsRecording())
+					{
+						if (ImGui::Button("Stop Recording"))
+						{
+							(*ServerState)->StopRecording();
+						}
+					}
+					else if (ImGui::Button("Record"))
+					{
+						(*ServerState)->StartRecording(GetRecordingPath(FString(), WorldContextIndex));
 					}
+					(*ServerState)->DrawStats();
 					break;
 				}
 			}
+
+			if (NumConnections > 1)
+			{
+				ImGui::Text("Connections: %d/%d", NumConnections, MaxServerConnections);
+			}
 		}
 		else
 		{
@@ -428,21 +1012,189 @@ bool FImGuiNetControl::ServerMenu(UWorld* World)
 
 void FImGuiNetControl::ServerCaptureInput(int32 InContextIndex)
 {
-	if (ServerState->IsConnected() && ContextIndex && *ContextIndex == InContextIndex)
+	TUniquePtr<FImguiServerState>* ServerState = ServerStates.Find(InContextIndex);
+	if (ServerState && (*ServerState)->IsConnected())
 	{
-		ServerState->CaptureInput();
+		(*ServerState)->CaptureInput();
 	}
 }
 
-TUniquePtr<ImDrawData> FImGuiNetControl::GetServerDrawData(int32 InContextIndex)
+TSharedPtr<const FImGuiRemoteDrawData, ESPMode::ThreadSafe> FImGuiNetControl::GetServerDrawData(int32 InContextIndex)
 {
-	if (ServerState->IsConnected() && ContextIndex && *ContextIndex == InContextIndex)
+	TUniquePtr<FImguiServerState>* ServerState = ServerStates.Find(InContextIndex);
+	if (ServerState)
 	{
-		return ServerState->GetDrawData();
+		return (*ServerState)->GetDrawData();
 	}
 	return nullptr;
 }
 
+void FImGuiNetControl::RequestTexturesResend(int32 InContextIndex, const FName& TextureName)
+{
+	TUniquePtr<FImguiServerState>* ServerState = ServerStates.Find(InContextIndex);
+	if (ServerState)
+	{
+		(*ServerState)->RequestTexturesResend(TextureName);
+	}
+}
+
+void FImGuiNetControl::BenchmarkDeltaCompression(const TArray<FString>& Args)
+{
+	const int32 FrameCount = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 16;
+	const int32 Iterations = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 100;
+
+	bool bAnyConnected = false;
+	for (auto& Pair : ServerStates)
+	{
+		if (Pair.Value->IsConnected())
+		{
+			Pair.Value->RequestDeltaBenchmark(FrameCount, Iterations);
+			bAnyConnected = true;
+		}
+	}
+
+	if (!bAnyConnected)
+	{
+		UE_LOG(LogImGuiNetControl, Warning, TEXT("Delta compression benchmark needs a connected NetImgui client."));
+	}
+}
+
+void FImGuiNetControl::BenchmarkPipeline(const TArray<FString>& Args)
+{
+	NetImGuiBenchmark::FPipelineSettings Settings;
+	if (Args.Num() > 0 && Args[0] != TEXT("Synthetic"))
+	{
+		Settings.RecordingFilename = GetRecordingPath(Args[0], INDEX_NONE);
+	}
+	Settings.Iterations = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : Settings.Iterations;
+	Settings.FrameCount = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : Settings.FrameCount;
+	Settings.OutputFilename = Args.Num() > 3 ? Args[3] : FString::Printf(TEXT("PipelineBenchmark_%s.json"), *FDateTime::Now().ToString());
+	if (FPaths::IsRelative(Settings.OutputFilename))
+	{
+		Settings.OutputFilename = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("NetImgui") / Settings.OutputFilename);
+	}
+	Settings.bEntropyCompression = CVars::NetImguiEntropyCompression.GetValueOnGameThread() > 0;
+
+	NetImGuiBenchmark::FPipelineResults Results;
+	NetImGuiBenchmark::RunPipeline(Settings, ContextManager->GetFontAtlas(), Results);
+}
+
+void FImGuiNetControl::StartRecording(const TArray<FString>& Args)
+{
+	const int32 NumConnected = Algo::CountIf(ServerStates, [](const auto& Pair) { return Pair.Value->IsConnected() && !Pair.Value->IsReplaying(); });
+	if (NumConnected == 0)
+	{
+		UE_LOG(LogImGuiNetControl, Warning, TEXT("NetImgui recording needs a connected NetImgui client."));
+		return;
+	}
+
+	for (auto& Pair : ServerStates)
+	{
+		if (Pair.Value->IsConnected() && !Pair.Value->IsReplaying())
+		{
+			FString Filename = Args.Num() > 0 ? Args[0] : FString();
+			if (NumConnected > 1 && !Filename.IsEmpty())
+			{
+				Filename = FPaths::GetBaseFilename(Filename, false) + FString::Printf(TEXT("_%d"), Pair.Key) + FPaths::GetExtension(Filename, true);
+			}
+			Pair.Value->StartRecording(GetRecordingPath(Filename, Pair.Key));
+		}
+	}
+}
+
+void FImGuiNetControl::StopRecording(const TArray<FString>& Args)
+{
+	for (auto& Pair : ServerStates)
+	{
+		Pair.Value->StopRecording();
+	}
+}
+
+void FImGuiNetControl::Replay(const TArray<FString>& Args)
+{
+	if (Args.Num() == 0)
+	{
+		UE_LOG(LogImGuiNetControl, Warning, TEXT("ImGui.NetImgui.Replay needs the filename of a recording."));
+		return;
+	}
+
+	int32 ReplayContextIndex = INDEX_NONE;
+	if (Args.Num() > 1)
+	{
+		ReplayContextIndex = FCString::Atoi(*Args[1]);
+	}
+	else
+	{
+		for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+		{
+			UWorld* World = WorldContext.World();
+			if (World && World->IsGameWorld())
+			{
+				ContextManager->GetWorldContextProxy(*World, ReplayContextIndex);
+				break;
+			}
+		}
+	}
+
+	if (ReplayContextIndex == INDEX_NONE)
+	{
+		UE_LOG(LogImGuiNetControl, Warning, TEXT("ImGui.NetImgui.Replay needs a game world or an explicit context index."));
+		return;
+	}
+
+	// States of closed connections are kept for reuse, so only open connections count towards the limit.
+	TUniquePtr<FImguiServerState>* ServerState = ServerStates.Find(ReplayContextIndex);
+	const bool bIsContextIdle = ServerState == nullptr || (*ServerState)->ConnectionState == EImguiConnectionState::None;
+	if (bIsContextIdle && GetNumConnections() >= MaxServerConnections)
+	{
+		UE_LOG(LogImGuiNetControl, Warning, TEXT("All %d NetImgui connections are in use."), MaxServerConnections);
+		return;
+	}
+
+	if (ServerState == nullptr)
+	{
+		ServerState = &ServerStates.Add(ReplayContextIndex, MakeUnique<FImguiServerState>(ReplayContextIndex));
+	}
+	(*ServerState)->Replay(GetRecordingPath(Args[0], ReplayContextIndex));
+}
+
+int32 FImGuiNetControl::GetNumConnections() const
+{
+	return Algo::CountIf(ServerStates, [](const auto& Pair)
+	{
+		return Pair.Value->ConnectionState != EImguiConnectionState::None;
+	});
+}
+
+void FImGuiNetControl::StopReplay(const TArray<FString>& Args)
+{
+	for (auto& Pair : ServerStates)
+	{
+		if (Pair.Value->IsReplaying())
+		{
+			Pair.Value->Disconnect();
+		}
+	}
+}
+
+FString FImGuiNetControl::GetRecordingPath(const FString& Filename, int32 InContextIndex)
+{
+	FString Path = Filename.IsEmpty()
+		? FString::Printf(TEXT("NetImgui_%d_%s"), InContextIndex, *FDateTime::Now().ToString())
+		: Filename;
+
+	if (FPaths::IsRelative(Path))
+	{
+		Path = FPaths::ProjectSavedDir() / TEXT("NetImgui") / Path;
+	}
+	if (FPaths::GetExtension(Path).IsEmpty())
+	{
+		Path += NetImguiRecordingExtension;
+	}
+
+	return FPaths::ConvertRelativePathToFull(Path);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // NetImgui HAL interface
 
@@ -485,7 +1237,7 @@ const char* NetImguiServer::App::HAL_GetUserSettingFolder()
 bool NetImguiServer::App::HAL_CreateTexture(uint16_t Width, uint16_t Height, NetImgui::eTexFormat Format, const uint8_t* pPixelData, ServerTexture& OutTexture)
 {
 	TStringBuilder<64> TextureNameString;
-	TextureNameString.Appendf(TEXT("NetImguiServer_%llu"), OutTexture.mImguiId);
+	TextureNameString.Appendf(TEXT("NetImguiServer_%d_%llu"), gTextureNamespace, OutTexture.mImguiId);
 	auto TextureName = FName(TextureNameString.ToString());
 
 	const uint32 BytesPerPixel = 4; // convert everything to use RGBA8
@@ -515,6 +1267,16 @@ bool NetImguiServer::App::HAL_CreateTexture(uint16_t Width, uint16_t Height, Net
 
 	if (TextureId != INDEX_NONE)
 	{
+		// Remote textures can be evicted, since they can be requested again from the client. Connection is looked up
+		// when reloading, as it may be closed by then.
+		if (gTexturesResendable)
+		{
+			TextureManager.SetTextureReloadCallback(TextureId, [ContextIndex = gTextureNamespace](const FName& Name)
+				{
+					FImGuiModuleManager::Get()->GetContextManager().GetNetControl().RequestTexturesResend(ContextIndex, Name);
+				});
+		}
+
 		OutTexture.mpHAL_Texture = reinterpret_cast<void*>(static_cast<uint64>(TextureId));
 		return true;
 	}
@@ -20,5 +20,12 @@ FImGuiTextureHandle::FImGuiTextureHandle(const FName& InName, ImTextureID InText
 		TEXT(" Name = '%s', TextureIndex(TextureId) = %d"), *Name.ToString(), Index);
 }
 
+FImGuiTextureHandle::FImGuiTextureHandle(const FName& InName, ImTextureID InTextureId, const ImVec2& InUV0, const ImVec2& InUV1)
+	: FImGuiTextureHandle(InName, InTextureId)
+{
+	UV0 = InUV0;
+	UV1 = InUV1;
+}
+
 // FImGuiTextureHandle::HasValidEntry() is implemented in ImGuiModule.cpp to get access to FImGuiModuleManager instance
 // without referencing in this class.
@@ -0,0 +1,411 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "NetImGuiBenchmark.h"
+
+#include "ImGuiDrawData.h"
+#include "imgui.h"
+#include "NetImgui_Config.h"
+#include "NetImgui_Api.h"
+#include "NetImguiServer_Recording.h"
+#include "NetImguiServer_RemoteClient.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogNetImGuiBenchmark, Log, All);
+
+namespace NetImGuiBenchmark
+{
+	namespace
+	{
+		// Stages of the pipeline, in the order in which frames go through them.
+		enum class EStage : uint8
+		{
+			ConvertToCmdDrawFrame,
+			CompressCmdDrawFrame,
+			DecompressCmdDrawFrame,
+			ConvertToImguiDrawData,
+			TransferDrawData,
+			ConvertToSlate,
+			Count
+		};
+
+		const TCHAR* GetStageName(EStage Stage)
+		{
+			static const TCHAR* Names[] = { TEXT("ConvertToCmdDrawFrame"), TEXT("CompressCmdDrawFrame"), TEXT("DecompressCmdDrawFrame"),
+				TEXT("ConvertToImguiDrawData"), TEXT("TransferDrawData"), TEXT("ConvertToSlate") };
+			static_assert(UE_ARRAY_COUNT(Names) == static_cast<int32>(EStage::Count), "Missing stage names");
+			return Names[static_cast<int32>(Stage)];
+		}
+
+		// Time spent in one stage, with the size of uncompressed draw frames that went through it.
+		struct FStageStats
+		{
+			uint64 Cycles = 0;
+			uint64 Bytes = 0;
+			int32 Frames = 0;
+
+			void Add(uint64 StartCycles, uint64 FrameSize)
+			{
+				Cycles += FPlatformTime::Cycles64() - StartCycles;
+				Bytes += FrameSize;
+				Frames++;
+			}
+
+			double GetSeconds() const { return FPlatformTime::ToSeconds64(Cycles); }
+			double GetFramesPerSecond() const { return Cycles > 0 ? Frames / GetSeconds() : 0.0; }
+			double GetMegabytesPerSecond() const { return Cycles > 0 ? Bytes / (1024.0 * 1024.0) / GetSeconds() : 0.0; }
+		};
+
+		struct FCompressionStats
+		{
+			uint64 UncompressedBytes = 0;
+			uint64 PackedBytes = 0;
+			uint64 EntropyBytesIn = 0;
+			uint64 EntropyBytesOut = 0;
+
+			double GetRatio() const { return PackedBytes > 0 ? static_cast<double>(UncompressedBytes) / PackedBytes : 1.0; }
+			double GetEntropyRatio() const { return EntropyBytesOut > 0 ? static_cast<double>(EntropyBytesIn) / EntropyBytesOut : 1.0; }
+		};
+
+		// Copy of the draw data of one frame, fed to the first stage of the pipeline.
+		struct FSourceFrame
+		{
+			ImDrawData DrawData;
+
+			FSourceFrame() = default;
+			FSourceFrame(const FSourceFrame&) = delete;
+			FSourceFrame& operator=(const FSourceFrame&) = delete;
+
+			~FSourceFrame()
+			{
+				for (ImDrawList* DrawList : DrawData.CmdLists)
+				{
+					IM_DELETE(DrawList);
+				}
+			}
+
+			void CopyFrom(const ImDrawData& Src)
+			{
+				DrawData.Valid = true;
+				DrawData.DisplayPos = Src.DisplayPos;
+				DrawData.DisplaySize = Src.DisplaySize;
+				DrawData.FramebufferScale = Src.FramebufferScale;
+				for (int Index = 0; Index < Src.CmdListsCount; Index++)
+				{
+					// Owner name pointer is the id used to match draw groups between frames.
+					ImDrawList* DrawList = Src.CmdLists[Index]->CloneOutput();
+					DrawList->_OwnerName = Src.CmdLists[Index]->_OwnerName;
+					DrawData.CmdLists.push_back(DrawList);
+					DrawData.TotalVtxCount += DrawList->VtxBuffer.Size;
+					DrawData.TotalIdxCount += DrawList->IdxBuffer.Size;
+				}
+				DrawData.CmdListsCount = DrawData.CmdLists.Size;
+			}
+		};
+
+		// Content similar to debug tools: a large, mostly static window, a table and a plot updated every frame, and
+		// a log that scrolls.
+		void DrawSyntheticFrame(int32 Frame)
+		{
+			ImGui::SetNextWindowPos(ImVec2(20.f, 20.f), ImGuiCond_Always);
+			ImGui::SetNextWindowSize(ImVec2(600.f, 1000.f), ImGuiCond_Always);
+			ImGui::ShowDemoWindow();
+
+			ImGui::SetNextWindowPos(ImVec2(640.f, 20.f), ImGuiCond_Always);
+			ImGui::SetNextWindowSize(ImVec2(700.f, 1000.f), ImGuiCond_Always);
+			if (ImGui::Begin("Benchmark Stats"))
+			{
+				float Values[128];
+				for (int32 Index = 0; Index < UE_ARRAY_COUNT(Values); Index++)
+				{
+					Values[Index] = FMath::Sin((Frame + Index) * 0.1f);
+				}
+				ImGui::PlotLines("Signal", Values, UE_ARRAY_COUNT(Values), 0, nullptr, -1.f, 1.f, ImVec2(0.f, 120.f));
+
+				if (ImGui::BeginTable("Actors", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+				{
+					for (int32 Row = 0; Row < 64; Row++)
+					{
+						const float Phase = (Frame + Row * 7) * 0.05f;
+						ImGui::TableNextRow();
+						ImGui::TableNextColumn();
+						ImGui::Text("Actor_%d", Row);
+						ImGui::TableNextColumn();
+						ImGui::Text("%.2f, %.2f", FMath::Cos(Phase) * 100.f, FMath::Sin(Phase) * 100.f);
+						ImGui::TableNextColumn();
+						ImGui::Text("%s", Row % 3 ? "Active" : "Idle");
+						ImGui::TableNextColumn();
+						ImGui::ProgressBar(FMath::Frac(Phase), ImVec2(-1.f, 0.f));
+					}
+					ImGui::EndTable();
+				}
+			}
+			ImGui::End();
+
+			ImGui::SetNextWindowPos(ImVec2(1360.f, 20.f), ImGuiCond_Always);
+			ImGui::SetNextWindowSize(ImVec2(540.f, 1000.f), ImGuiCond_Always);
+			if (ImGui::Begin("Benchmark Log"))
+			{
+				for (int32 Line = FMath::Max(0, Frame * 2 - 200); Line < Frame * 2; Line++)
+				{
+					ImGui::Text("[%8.3f] Event %d received from channel %d", Line / 120.f, Line, Line % 5);
+				}
+				ImGui::SetScrollHereY(1.f);
+			}
+			ImGui::End();
+		}
+
+		void GenerateFrames(int32 FrameCount, TArray<FSourceFrame>& OutFrames)
+		{
+			ImGuiIO& IO = ImGui::GetIO();
+			IO.IniFilename = nullptr;
+			IO.LogFilename = nullptr;
+			IO.DisplaySize = ImVec2(1920.f, 1080.f);
+			IO.DeltaTime = 1.f / 60.f;
+
+			for (int32 Frame = 0; Frame < FrameCount; Frame++)
+			{
+				ImGui::NewFrame();
+				DrawSyntheticFrame(Frame);
+				ImGui::Render();
+				OutFrames.AddDefaulted_GetRef().CopyFrom(*ImGui::GetDrawData());
+			}
+		}
+
+		bool ReadRecordingFrames(const FString& Filename, int32 FrameCount, TArray<FSourceFrame>& OutFrames)
+		{
+			NetImguiServer::Recording::Player Player;
+			if (!Player.Open(TCHAR_TO_ANSI(*Filename)))
+			{
+				UE_LOG(LogNetImGuiBenchmark, Error, TEXT("Failed to open NetImgui recording '%s' (missing, corrupted or made by another version)."),
+					*Filename);
+				return false;
+			}
+
+			// Commands are decoded by a client like during a replay, one timestamp at a time to take every frame. Textures
+			// are not needed without rendering.
+			NetImguiServer::RemoteClient::Client Client;
+			Client.Initialize();
+
+			bool bMoreChunks = true;
+			while (bMoreChunks && OutFrames.Num() < FrameCount)
+			{
+				bMoreChunks = Player.Update(Client, Player.GetNextTimeUs());
+				Client.DiscardPendingTextures();
+				if (NetImguiServer::RemoteClient::NetImguiImDrawData* DrawData = Client.mPendingImguiDrawDataIn.Release())
+				{
+					OutFrames.AddDefaulted_GetRef().CopyFrom(*DrawData);
+					NetImgui::Internal::netImguiDeleteSafe(DrawData);
+				}
+			}
+
+			if (OutFrames.Num() < 2)
+			{
+				UE_LOG(LogNetImGuiBenchmark, Error, TEXT("NetImgui recording '%s' doesn't have enough frames to benchmark."), *Filename);
+				return false;
+			}
+			return true;
+		}
+
+		bool SaveResults(const FPipelineSettings& Settings, int32 FrameCount, uint8 EntropyCodec, const FStageStats (&Stages)[static_cast<int32>(EStage::Count)],
+			const FCompressionStats& Compression, int32 NumDecodeErrors)
+		{
+			FString Json;
+			TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+			Writer->WriteValue(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+			Writer->WriteValue(TEXT("Source"), Settings.RecordingFilename.IsEmpty() ? TEXT("Synthetic") : *FPaths::GetCleanFilename(Settings.RecordingFilename));
+			Writer->WriteValue(TEXT("Frames"), FrameCount);
+			Writer->WriteValue(TEXT("Iterations"), Settings.Iterations);
+			Writer->WriteValue(TEXT("EntropyCodec"), static_cast<int32>(EntropyCodec));
+			Writer->WriteValue(TEXT("DecodeErrors"), NumDecodeErrors);
+
+			Writer->WriteArrayStart(TEXT("Stages"));
+			for (int32 Index = 0; Index < static_cast<int32>(EStage::Count); Index++)
+			{
+				const FStageStats& Stage = Stages[Index];
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("Name"), GetStageName(static_cast<EStage>(Index)));
+				Writer->WriteValue(TEXT("Frames"), Stage.Frames);
+				Writer->WriteValue(TEXT("Seconds"), Stage.GetSeconds());
+				Writer->WriteValue(TEXT("FramesPerSecond"), Stage.GetFramesPerSecond());
+				Writer->WriteValue(TEXT("MegabytesPerSecond"), Stage.GetMegabytesPerSecond());
+				Writer->WriteObjectEnd();
+			}
+			Writer->WriteArrayEnd();
+
+			Writer->WriteObjectStart(TEXT("Compression"));
+			Writer->WriteValue(TEXT("UncompressedBytes"), static_cast<int64>(Compression.UncompressedBytes));
+			Writer->WriteValue(TEXT("PackedBytes"), static_cast<int64>(Compression.PackedBytes));
+			Writer->WriteValue(TEXT("Ratio"), Compression.GetRatio());
+			Writer->WriteValue(TEXT("EntropyRatio"), Compression.GetEntropyRatio());
+			Writer->WriteObjectEnd();
+
+			Writer->WriteObjectEnd();
+			Writer->Close();
+
+			IFileManager::Get().MakeDirectory(*FPaths::GetPath(Settings.OutputFilename), true);
+			return FFileHelper::SaveStringToFile(Json, *Settings.OutputFilename);
+		}
+	}
+
+	bool RunPipeline(const FPipelineSettings& Settings, ImFontAtlas& FontAtlas, FPipelineResults& OutResults)
+	{
+		using namespace NetImgui::Internal;
+
+		// Generated frames keep the ids of their draw groups (window name pointers) valid until the end.
+		ImGuiContext* PreviousContext = ImGui::GetCurrentContext();
+		ImGuiContext* Context = Settings.RecordingFilename.IsEmpty() ? ImGui::CreateContext(&FontAtlas) : nullptr;
+		ON_SCOPE_EXIT
+		{
+			if (Context)
+			{
+				ImGui::DestroyContext(Context);
+				ImGui::SetCurrentContext(PreviousContext);
+			}
+		};
+
+		TArray<FSourceFrame> Frames;
+		const int32 FrameCount = FMath::Max(Settings.FrameCount, 2);
+		if (Context)
+		{
+			ImGui::SetCurrentContext(Context);
+			GenerateFrames(FrameCount, Frames);
+		}
+		else if (!ReadRecordingFrames(Settings.RecordingFilename, FrameCount, Frames))
+		{
+			return false;
+		}
+
+		const uint8 EntropyCodec = Settings.bEntropyCompression ? EntropyCodecSelect(EntropyCodecsSupported()) : kEntropyCodec_None;
+		FStageStats Stages[static_cast<int32>(EStage::Count)];
+		FCompressionStats Compression;
+		int32 NumDecodeErrors = 0;
+		int32 NumDeltaMismatches = 0;
+
+		NetImguiServer::RemoteClient::Client Client;
+		FImGuiSlateDrawList SlateDrawList;
+
+		// Frames go through the same steps as when received from a game server, with the first frame of each iteration
+		// sent uncompressed.
+		for (int32 Iteration = 0; Iteration < Settings.Iterations; Iteration++)
+		{
+			CmdDrawFrame* PrevFrame = nullptr;
+			CmdDrawFrame* PrevDecodedFrame = nullptr;
+
+			for (const FSourceFrame& Frame : Frames)
+			{
+				uint64 StartCycles = FPlatformTime::Cycles64();
+				CmdDrawFrame* NewFrame = ConvertToCmdDrawFrame(&Frame.DrawData, ImGuiMouseCursor_Arrow, kVertexFormat_Palette);
+				const uint64 FrameSize = NewFrame->mUncompressedSize;
+				Stages[static_cast<int32>(EStage::ConvertToCmdDrawFrame)].Add(StartCycles, FrameSize);
+
+				CmdDrawFrame* DecodedFrame = nullptr;
+				if (PrevFrame)
+				{
+					DeltaBenchmarkResult DeltaResult;
+					if (Settings.bVerifyDeltaCompression && Iteration == 0 && !BenchmarkDeltaCompression(PrevFrame, NewFrame, 1, DeltaResult))
+					{
+						NumDeltaMismatches++;
+					}
+
+					StartCycles = FPlatformTime::Cycles64();
+					CmdDrawFrame* PackedFrame = CompressCmdDrawFrame(PrevFrame, NewFrame, EntropyCodec);
+					Stages[static_cast<int32>(EStage::CompressCmdDrawFrame)].Add(StartCycles, FrameSize);
+
+					Compression.UncompressedBytes += FrameSize;
+					Compression.PackedBytes += PackedFrame->mHeader.mSize;
+					Compression.EntropyBytesIn += PackedFrame->mEntropySizeIn;
+					Compression.EntropyBytesOut += PackedFrame->mEntropySizeOut;
+
+					uint32_t EntropyDecodeUs = 0;
+					StartCycles = FPlatformTime::Cycles64();
+					DecodedFrame = DecompressCmdDrawFrame(PrevDecodedFrame, PackedFrame, EntropyDecodeUs);
+					Stages[static_cast<int32>(EStage::DecompressCmdDrawFrame)].Add(StartCycles, FrameSize);
+					netImguiDeleteSafe(PackedFrame);
+
+					if (DecodedFrame == nullptr)
+					{
+						NumDecodeErrors++;
+					}
+				}
+
+				// Uncompressed frames are used as they are, keep a copy for the next decompression.
+				if (DecodedFrame == nullptr)
+				{
+					DecodedFrame = CloneCmdDrawFrame(NewFrame);
+				}
+
+				StartCycles = FPlatformTime::Cycles64();
+				NetImguiServer::RemoteClient::NetImguiImDrawData* ImguiDrawData = Client.ConvertToImguiDrawData(DecodedFrame);
+				Stages[static_cast<int32>(EStage::ConvertToImguiDrawData)].Add(StartCycles, FrameSize);
+
+				StartCycles = FPlatformTime::Cycles64();
+				FImGuiDrawList DrawList;
+				DrawList.TransferDrawData(*ImguiDrawData->CmdLists[0]);
+				Stages[static_cast<int32>(EStage::TransferDrawData)].Add(StartCycles, FrameSize);
+
+				const FSlateRect ClippingRect(Frame.DrawData.DisplayPos.x, Frame.DrawData.DisplayPos.y,
+					Frame.DrawData.DisplayPos.x + Frame.DrawData.DisplaySize.x, Frame.DrawData.DisplayPos.y + Frame.DrawData.DisplaySize.y);
+				StartCycles = FPlatformTime::Cycles64();
+				DrawList.ConvertToSlate(SlateDrawList, FTransform2D(), ClippingRect);
+				Stages[static_cast<int32>(EStage::ConvertToSlate)].Add(StartCycles, FrameSize);
+
+				netImguiDeleteSafe(ImguiDrawData);
+				netImguiDeleteSafe(PrevFrame);
+				netImguiDeleteSafe(PrevDecodedFrame);
+				PrevFrame = NewFrame;
+				PrevDecodedFrame = DecodedFrame;
+			}
+
+			netImguiDeleteSafe(PrevFrame);
+			netImguiDeleteSafe(PrevDecodedFrame);
+		}
+
+		const FStageStats& FirstStage = Stages[static_cast<int32>(EStage::ConvertToCmdDrawFrame)];
+		UE_LOG(LogNetImGuiBenchmark, Log, TEXT("NetImgui pipeline benchmark: %d frames x %d iterations from %s, %.1f KB per frame."),
+			Frames.Num(), Settings.Iterations, Settings.RecordingFilename.IsEmpty() ? TEXT("synthetic frames") : *Settings.RecordingFilename,
+			FirstStage.Frames > 0 ? FirstStage.Bytes / 1024.0 / FirstStage.Frames : 0.0);
+		for (int32 Index = 0; Index < static_cast<int32>(EStage::Count); Index++)
+		{
+			UE_LOG(LogNetImGuiBenchmark, Log, TEXT("  %-24s %10.1f frames/s %10.1f MB/s"), GetStageName(static_cast<EStage>(Index)),
+				Stages[Index].GetFramesPerSecond(), Stages[Index].GetMegabytesPerSecond());
+		}
+		UE_LOG(LogNetImGuiBenchmark, Log, TEXT("  Compression ratio: %.2f (entropy coding %.2f)"), Compression.GetRatio(), Compression.GetEntropyRatio());
+		if (NumDecodeErrors > 0)
+		{
+			UE_LOG(LogNetImGuiBenchmark, Error, TEXT("NetImgui pipeline benchmark: %d frames failed to decompress."), NumDecodeErrors);
+		}
+		if (NumDeltaMismatches > 0)
+		{
+			UE_LOG(LogNetImGuiBenchmark, Error, TEXT("NetImgui pipeline benchmark: %d frame pairs produced data different from the reference implementation."),
+				NumDeltaMismatches);
+		}
+
+		OutResults.NumFrames = Frames.Num();
+		OutResults.NumDecodeErrors = NumDecodeErrors;
+		OutResults.NumDeltaMismatches = NumDeltaMismatches;
+
+		if (Settings.OutputFilename.IsEmpty())
+		{
+			return true;
+		}
+
+		if (!SaveResults(Settings, Frames.Num(), EntropyCodec, Stages, Compression, NumDecodeErrors))
+		{
+			UE_LOG(LogNetImGuiBenchmark, Error, TEXT("Failed to save NetImgui pipeline benchmark results to '%s'."), *Settings.OutputFilename);
+			return false;
+		}
+
+		UE_LOG(LogNetImGuiBenchmark, Log, TEXT("NetImgui pipeline benchmark results saved to '%s'."), *Settings.OutputFilename);
+		return true;
+	}
+}
@@ -0,0 +1,55 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+
+struct ImFontAtlas;
+
+// Headless benchmark of the NetImgui draw data pipeline, from Dear ImGui draw data on the game server to Slate vertices
+// on the viewing client. All stages run in-process on the calling thread, without sockets or rendering, so it can run
+// in automated builds (e.g. -ExecCmds="ImGui.NetImgui.BenchmarkPipeline,Quit" -nullrhi).
+namespace NetImGuiBenchmark
+{
+	struct FPipelineSettings
+	{
+		// Recording replayed as the source of frames. Frames are generated by a local ImGui context when empty.
+		FString RecordingFilename;
+
+		// Number of frames generated or read from the recording.
+		int32 FrameCount = 120;
+
+		// Number of times all frames are sent through the pipeline.
+		int32 Iterations = 10;
+
+		// Whether delta compressed frames are also entropy coded, with the codec a game server would select.
+		bool bEntropyCompression = false;
+
+		// Whether delta compression of each frame pair is compared with the reference implementation (in the first
+		// iteration, outside of measured stages).
+		bool bVerifyDeltaCompression = false;
+
+		// File in which results are saved as JSON. Results are only logged when empty.
+		FString OutputFilename;
+	};
+
+	struct FPipelineResults
+	{
+		// Number of frames sent through the pipeline in each iteration.
+		int32 NumFrames = 0;
+
+		// Number of compressed frames that failed to decompress.
+		int32 NumDecodeErrors = 0;
+
+		// Number of frame pairs compressed or decompressed differently from the reference implementation.
+		int32 NumDeltaMismatches = 0;
+	};
+
+	// Send frames through all stages of the pipeline, log the results and save them to the output file.
+	// @param Settings - Source of frames, iterations and output of the benchmark
+	// @param FontAtlas - Built font atlas, used to generate frames when not reading them from a recording
+	// @param OutResults - Results, to check the pipeline in automated tests
+	// @returns True, if the benchmark completed and its results were saved
+	bool RunPipeline(const FPipelineSettings& Settings, ImFontAtlas& FontAtlas, FPipelineResults& OutResults);
+}
@@ -17,6 +17,7 @@
 #include "NetImguiServer_RemoteClient.cpp"
 #include "NetImguiServer_Network.cpp"
 #include "NetImguiServer_App.cpp"
+#include "NetImguiServer_Recording.cpp"
 // #include "NetImguiServer_UI.cpp" // we provide our own UI layer
 #include "Custom/NetImguiServer_App_Custom.cpp"
 #pragma warning(pop)
@@ -0,0 +1,180 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiContextManager.h"
+#include "ImGuiContextProxy.h"
+#include "ImGuiModuleManager.h"
+#include "ImGuiModuleSettings.h"
+
+#include <HAL/IConsoleManager.h>
+#include <Misc/AutomationTest.h>
+#include <Templates/UnrealTemplate.h>
+#include <UObject/UnrealType.h>
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ImGuiContextProxyTests
+{
+	// Enable idle frame skipping in the settings object for the lifetime of this object. Properties are not accessible
+	// outside of the settings, so they are set through reflection and applied by reloading module settings.
+	struct FScopedIdleFrameSkipping
+	{
+		FScopedIdleFrameSkipping(float MaxIdleInterval)
+			: Settings(UImGuiSettings::Get())
+			, EnabledProperty(FindFProperty<FBoolProperty>(UImGuiSettings::StaticClass(), TEXT("bEnableIdleFrameSkipping")))
+			, IntervalProperty(FindFProperty<FFloatProperty>(UImGuiSettings::StaticClass(), TEXT("MaxIdleInterval")))
+		{
+			if (IsValid())
+			{
+				bOldEnabled = EnabledProperty->GetPropertyValue_InContainer(Settings);
+				OldInterval = IntervalProperty->GetPropertyValue_InContainer(Settings);
+				Apply(true, MaxIdleInterval);
+			}
+		}
+
+		~FScopedIdleFrameSkipping()
+		{
+			if (IsValid())
+			{
+				Apply(bOldEnabled, OldInterval);
+			}
+		}
+
+		bool IsValid() const { return Settings && EnabledProperty && IntervalProperty; }
+
+	private:
+
+		void Apply(bool bEnabled, float Interval)
+		{
+			EnabledProperty->SetPropertyValue_InContainer(Settings, bEnabled);
+			IntervalProperty->SetPropertyValue_InContainer(Settings, Interval);
+			UImGuiSettings::OnSettingsLoaded.Broadcast();
+		}
+
+		UImGuiSettings* Settings;
+		FBoolProperty* EnabledProperty;
+		FFloatProperty* IntervalProperty;
+		bool bOldEnabled = false;
+		float OldInterval = 0.f;
+	};
+
+	// Set a console variable for the lifetime of this object, restoring its value with the original priority.
+	struct FScopedConsoleVariable
+	{
+		FScopedConsoleVariable(const TCHAR* Name, const TCHAR* Value)
+			: Variable(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			if (Variable)
+			{
+				OldValue = Variable->GetString();
+				OldPriority = (EConsoleVariableFlags)(Variable->GetFlags() & ECVF_SetByMask);
+				Variable->Set(Value, OldPriority);
+			}
+		}
+
+		~FScopedConsoleVariable()
+		{
+			if (Variable)
+			{
+				Variable->Set(*OldValue, OldPriority);
+			}
+		}
+
+	private:
+
+		IConsoleVariable* Variable;
+		FString OldValue;
+		EConsoleVariableFlags OldPriority = ECVF_SetByCode;
+	};
+}
+
+// Tick an idle context and check that skipped frames keep presenting the last draw data, and that ImGui calls made
+// outside of draw events while frames are skipped don't reach the context.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiIdleFrameSkippingTest, "ImGui.ContextProxy.IdleFrameSkipping",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiIdleFrameSkippingTest::RunTest(const FString& Parameters)
+{
+	using namespace ImGuiContextProxyTests;
+
+	FImGuiModuleManager* ModuleManager = FImGuiModuleManager::Get();
+	if (!TestNotNull(TEXT("ImGui module manager"), ModuleManager))
+	{
+		return false;
+	}
+
+	FScopedIdleFrameSkipping IdleFrameSkipping(3600.f);
+	if (!TestTrue(TEXT("Idle frame skipping settings found"), IdleFrameSkipping.IsValid()))
+	{
+		return false;
+	}
+
+	// Throttling would also skip frames, including the ones that we expect to be updated.
+	FScopedConsoleVariable MaxUpdateRate(TEXT("ImGui.MaxUpdateRate"), TEXT("0"));
+
+	FImGuiContextManager& ContextManager = ModuleManager->GetContextManager();
+	ImGuiContext* OldContext = ImGui::GetCurrentContext();
+
+	{
+		FImGuiContextProxy ContextProxy(TEXT("IdleFrameSkippingTest"), Utilities::INVALID_CONTEXT_INDEX,
+			&ContextManager.GetFontAtlas(), 1.f);
+
+		// Context ticks once per engine frame, so we advance the frame number for each tick.
+		TGuardValue<uint32> FrameNumberGuard(GFrameNumber, GFrameNumber);
+		const auto TickContext = [&]()
+		{
+			GFrameNumber++;
+			ContextProxy.Tick(1.f / 60.f, ContextManager);
+		};
+
+		// Tick until context becomes idle and stops publishing frames.
+		uint32 LastFrameId = ContextProxy.GetDrawData()->FrameId;
+		for (int32 Index = 0; Index < 10; Index++)
+		{
+			TickContext();
+
+			const uint32 FrameId = ContextProxy.GetDrawData()->FrameId;
+			if (FrameId == LastFrameId)
+			{
+				break;
+			}
+			LastFrameId = FrameId;
+		}
+
+		const FImGuiContextProxy::FFrameDrawDataRef IdleFrame = ContextProxy.GetDrawData();
+		TestTrue(TEXT("Context published frames before becoming idle"), IdleFrame->FrameId > 0);
+
+		for (int32 Index = 0; Index < 10; Index++)
+		{
+			// Draw like an actor tick would do.
+			ContextProxy.SetAsCurrentForWorldTick();
+			TestFalse(TEXT("Calls in skipped frames reach the context"), ContextProxy.IsCurrentContext());
+			ImGui::Begin("IdleFrameSkippingTest");
+			ImGui::Text("Frame %u", GFrameNumber);
+			ImGui::End();
+
+			TickContext();
+
+			const FImGuiContextProxy::FFrameDrawDataRef Frame = ContextProxy.GetDrawData();
+			if (!TestTrue(TEXT("Idle context presents the last draw data"), &*Frame == &*IdleFrame))
+			{
+				break;
+			}
+		}
+
+		// Updated frames should draw only what they drew before, without windows from skipped frames.
+		ContextProxy.RequestRedraw();
+		TickContext();
+		TickContext();
+
+		const FImGuiContextProxy::FFrameDrawDataRef RedrawnFrame = ContextProxy.GetDrawData();
+		TestTrue(TEXT("Context published a frame after redraw request"), RedrawnFrame->FrameId > IdleFrame->FrameId);
+		TestEqual(TEXT("Number of draw lists after redraw"), RedrawnFrame->DrawLists.Num(), IdleFrame->DrawLists.Num());
+	}
+
+	ImGui::SetCurrentContext(OldContext);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
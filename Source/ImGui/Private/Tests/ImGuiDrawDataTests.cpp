@@ -0,0 +1,443 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiDrawData.h"
+
+#include <HAL/PlatformTime.h>
+#include <Math/RandomStream.h>
+#include <Misc/AutomationTest.h>
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ImGuiDrawDataTests
+{
+	// Fill vertices with random positions in a range typical for ImGui windows and random UVs and colours.
+	void MakeRandomVertices(TArray<ImDrawVert>& OutVertices, int32 NumVertices, FRandomStream& Random)
+	{
+		OutVertices.SetNumUninitialized(NumVertices);
+		for (ImDrawVert& Vertex : OutVertices)
+		{
+			Vertex.pos = ImVec2{ Random.FRandRange(-4096.f, 4096.f), Random.FRandRange(-4096.f, 4096.f) };
+			Vertex.uv = ImVec2{ Random.FRand(), Random.FRand() };
+			Vertex.col = (ImU32)Random.GetUnsignedInt();
+		}
+	}
+
+	// Random transform with rotation, non-uniform scale and translation.
+	FTransform2D MakeRandomTransform(FRandomStream& Random)
+	{
+		const FScale2D Scale{ Random.FRandRange(0.1f, 8.f), Random.FRandRange(0.1f, 8.f) };
+		const FQuat2D Rotation{ Random.FRandRange(-PI, PI) };
+		const FVector2D Translation{ Random.FRandRange(-10000.f, 10000.f), Random.FRandRange(-10000.f, 10000.f) };
+		return FTransform2D{ Scale }.Concatenate(FTransform2D{ Rotation }).Concatenate(FTransform2D{ Translation });
+	}
+
+	// Build a synthetic draw list with commands drawing VerticesPerCommand consecutive vertices each. A new vertex offset
+	// segment starts every VerticesPerSegment vertices, like ImGui does when 16-bit indices run out of range.
+	// @param OutDrawList - Draw list that receives the data
+	// @param OutSource - Optional copy of the source ImGui data, for code that needs to access it directly
+	// @param NumVertices - Total number of vertices
+	// @param VerticesPerCommand - Number of vertices per draw command (multiple of 3)
+	// @param VerticesPerSegment - Number of vertices per vertex offset segment (multiple of VerticesPerCommand)
+	// @param Random - Random stream used to generate vertices
+	void MakeDrawList(FImGuiDrawList& OutDrawList, ImDrawList* OutSource, int32 NumVertices, int32 VerticesPerCommand,
+		int32 VerticesPerSegment, FRandomStream& Random)
+	{
+		check(VerticesPerCommand % 3 == 0 && VerticesPerSegment % VerticesPerCommand == 0);
+
+		ImDrawList Source{ nullptr };
+
+		TArray<ImDrawVert> Vertices;
+		MakeRandomVertices(Vertices, NumVertices, Random);
+		for (ImDrawVert& Vertex : Vertices)
+		{
+			// Keep all vertices inside of the clipping rectangle, so nothing is culled.
+			Vertex.pos = ImVec2{ FMath::Abs(Vertex.pos.x) * 0.5f, FMath::Abs(Vertex.pos.y) * 0.5f };
+		}
+		Source.VtxBuffer.resize(NumVertices);
+		FMemory::Memcpy(Source.VtxBuffer.Data, Vertices.GetData(), NumVertices * sizeof(ImDrawVert));
+
+		// Vertices that don't make a full triangle are not referenced.
+		const int32 NumReferencedVertices = NumVertices - NumVertices % 3;
+		for (int32 FirstVertex = 0; FirstVertex < NumReferencedVertices; FirstVertex += VerticesPerCommand)
+		{
+			ImDrawCmd Command;
+			Command.ClipRect = ImVec4{ 0.f, 0.f, 4096.f, 4096.f };
+			Command.VtxOffset = FirstVertex - FirstVertex % VerticesPerSegment;
+			Command.IdxOffset = Source.IdxBuffer.Size;
+
+			const int32 EndVertex = FMath::Min(FirstVertex + VerticesPerCommand, NumReferencedVertices);
+			for (int32 Vertex = FirstVertex; Vertex < EndVertex; Vertex++)
+			{
+				Source.IdxBuffer.push_back(static_cast<ImDrawIdx>(Vertex - Command.VtxOffset));
+			}
+
+			Command.ElemCount = Source.IdxBuffer.Size - Command.IdxOffset;
+			Source.CmdBuffer.push_back(Command);
+		}
+
+		if (OutSource)
+		{
+			OutSource->VtxBuffer = Source.VtxBuffer;
+			OutSource->IdxBuffer = Source.IdxBuffer;
+			OutSource->CmdBuffer = Source.CmdBuffer;
+		}
+
+		OutDrawList.TransferDrawData(Source);
+	}
+
+	bool AreVerticesIdentical(const FSlateVertex& Lhs, const FSlateVertex& Rhs)
+	{
+		return Lhs.Position == Rhs.Position && Lhs.Color == Rhs.Color
+			&& FMemory::Memcmp(Lhs.TexCoords, Rhs.TexCoords, sizeof(Lhs.TexCoords)) == 0;
+	}
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// Convert draw list and check that every index of converted commands and of batches built from them references
+	// the same vertex as in the source data.
+	// @param Test - Test that receives errors
+	// @param DrawList - Draw list with data transferred from Source
+	// @param Source - Copy of the source ImGui data
+	// @param OutNumBatches - Number of batches needed to submit the draw list
+	// @param OutMaxBatchVertices - Maximum number of vertices in one batch
+	// @returns True, if all indices reference the correct vertices
+	bool TestIndexMapping(FAutomationTestBase& Test, const FImGuiDrawList& DrawList, const ImDrawList& Source, int32& OutNumBatches,
+		int32& OutMaxBatchVertices)
+	{
+		const FTransform2D Transform;
+		const FSlateRect ClippingRect{ 0.f, 0.f, 8192.f, 8192.f };
+
+		// Source vertices referenced by all indices, in draw order.
+		TArray<FSlateVertex> ExpectedVertices;
+		ExpectedVertices.SetNumUninitialized(Source.IdxBuffer.Size);
+		int32 IndexBufferOffset = 0;
+		for (const ImDrawCmd& Command : Source.CmdBuffer)
+		{
+			for (uint32 Idx = 0; Idx < Command.ElemCount; Idx++, IndexBufferOffset++)
+			{
+				const int32 Vertex = (int32)Command.VtxOffset + (int32)Source.IdxBuffer[IndexBufferOffset];
+				ImGuiVertexConversion::CopyScalar(&ExpectedVertices[IndexBufferOffset], &Source.VtxBuffer[Vertex], 1, Transform);
+			}
+		}
+
+		FImGuiSlateDrawList SlateDrawList;
+		DrawList.ConvertToSlate(SlateDrawList, Transform, ClippingRect);
+
+		if (!Test.TestEqual(TEXT("Number of converted commands"), SlateDrawList.Commands.Num(), Source.CmdBuffer.Size)
+			|| !Test.TestEqual(TEXT("Number of converted indices"), SlateDrawList.Indices.Num(), Source.IdxBuffer.Size))
+		{
+			return false;
+		}
+
+		// Indices of converted commands are relative to the first vertex of the command.
+		int32 ExpectedIdx = 0;
+		for (const FImGuiSlateDrawCommand& Command : SlateDrawList.Commands)
+		{
+			SlateIndex MinIndex = TNumericLimits<SlateIndex>::Max();
+			for (int32 Idx = Command.FirstIndex; Idx < Command.FirstIndex + Command.NumIndices; Idx++, ExpectedIdx++)
+			{
+				const SlateIndex Index = SlateDrawList.Indices[Idx];
+				MinIndex = FMath::Min(MinIndex, Index);
+				if ((int32)Index >= Command.NumVertices
+					|| !AreVerticesIdentical(SlateDrawList.Vertices[Command.FirstVertex + Index], ExpectedVertices[ExpectedIdx]))
+				{
+					Test.AddError(FString::Printf(TEXT("Converted index %d references wrong vertex."), Idx));
+					return false;
+				}
+			}
+
+			if (Command.NumIndices > 0 && MinIndex != 0)
+			{
+				Test.AddError(FString::Printf(TEXT("Command indices are not rebased (lowest index is %u)."), (uint32)MinIndex));
+				return false;
+			}
+		}
+
+		// Batches concatenate vertices of commands and rebase their indices.
+		OutNumBatches = 0;
+		OutMaxBatchVertices = 0;
+		ExpectedIdx = 0;
+
+		FImGuiSlateDrawBatch Batch;
+		const auto FlushBatch = [&]()
+		{
+			if (!Batch.IsEmpty())
+			{
+				OutNumBatches++;
+				OutMaxBatchVertices = FMath::Max(OutMaxBatchVertices, Batch.Vertices.Num());
+
+				for (const SlateIndex Index : Batch.Indices)
+				{
+					if ((int32)Index >= Batch.Vertices.Num() || !AreVerticesIdentical(Batch.Vertices[Index], ExpectedVertices[ExpectedIdx++]))
+					{
+						return false;
+					}
+				}
+			}
+
+			Batch.Reset();
+			return true;
+		};
+
+		for (const FImGuiSlateDrawCommand& Command : SlateDrawList.Commands)
+		{
+			if (!Batch.CanAdd(Command) && !FlushBatch())
+			{
+				Test.AddError(FString::Printf(TEXT("Batch %d index references wrong vertex."), OutNumBatches));
+				return false;
+			}
+
+			Batch.Add(SlateDrawList, Command);
+		}
+
+		if (!FlushBatch())
+		{
+			Test.AddError(FString::Printf(TEXT("Batch %d index references wrong vertex."), OutNumBatches));
+			return false;
+		}
+
+		return Test.TestTrue(TEXT("Batch vertices addressable by SlateIndex"),
+			(int64)OutMaxBatchVertices <= (int64)TNumericLimits<SlateIndex>::Max() + 1);
+	}
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+}
+
+
+#if IMGUI_VECTORIZED_VERTEX_CONVERSION
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiVectorizedVertexConversionTest, "ImGui.DrawData.VectorizedVertexConversion",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiVectorizedVertexConversionTest::RunTest(const FString& Parameters)
+{
+	using namespace ImGuiDrawDataTests;
+
+	FRandomStream Random{ 0x1A6E };
+
+	constexpr int32 NumTransforms = 64;
+	for (int32 TransformNb = 0; TransformNb < NumTransforms; TransformNb++)
+	{
+		const FTransform2D Transform = (TransformNb == 0) ? FTransform2D{} : MakeRandomTransform(Random);
+
+		// Number of vertices is not a multiple of vectorized block, so the scalar tail is also exercised.
+		const int32 NumVertices = Random.RandRange(1, 1024) * ImGuiVertexConversion::VerticesPerIteration + Random.RandRange(0, 3);
+
+		TArray<ImDrawVert> ImGuiVertices;
+		MakeRandomVertices(ImGuiVertices, NumVertices, Random);
+
+		TArray<FSlateVertex> ScalarVertices;
+		ScalarVertices.SetNumZeroed(NumVertices);
+		ImGuiVertexConversion::CopyScalar(ScalarVertices.GetData(), ImGuiVertices.GetData(), NumVertices, Transform);
+
+		TArray<FSlateVertex> VectorizedVertices;
+		VectorizedVertices.SetNumZeroed(NumVertices);
+		const int32 NumVectorized = ImGuiVertexConversion::CopyVectorized(VectorizedVertices.GetData(), ImGuiVertices.GetData(),
+			NumVertices, Transform);
+		ImGuiVertexConversion::CopyScalar(VectorizedVertices.GetData() + NumVectorized, ImGuiVertices.GetData() + NumVectorized,
+			NumVertices - NumVectorized, Transform);
+
+		TestEqual(TEXT("Number of vectorized vertices"), NumVectorized, NumVertices - NumVertices % ImGuiVertexConversion::VerticesPerIteration);
+
+		for (int32 Idx = 0; Idx < NumVertices; Idx++)
+		{
+			if (!AreVerticesIdentical(ScalarVertices[Idx], VectorizedVertices[Idx]))
+			{
+				AddError(FString::Printf(TEXT("Transform %d, vertex %d: vectorized (%s, %s) differs from scalar (%s, %s)."),
+					TransformNb, Idx, *VectorizedVertices[Idx].Position.ToString(), *VectorizedVertices[Idx].Color.ToString(),
+					*ScalarVertices[Idx].Position.ToString(), *ScalarVertices[Idx].Color.ToString()));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+#endif // IMGUI_VECTORIZED_VERTEX_CONVERSION
+
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiDrawDataPaintBenchmark, "ImGui.DrawData.PaintBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FImGuiDrawDataPaintBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ImGuiDrawDataTests;
+
+	// Synthetic list similar to a large window: 100k vertices in commands of ~300 vertices and vertex offset segments
+	// that fit 16-bit indices.
+	constexpr int32 NumVertices = 100000;
+	constexpr int32 VerticesPerCommand = 297;
+	constexpr int32 VerticesPerSegment = VerticesPerCommand * 200;
+	constexpr int32 NumIterations = 5;
+
+	FRandomStream Random{ 0x1A6E };
+	FImGuiDrawList DrawList;
+	ImDrawList Source{ nullptr };
+	MakeDrawList(DrawList, &Source, NumVertices, VerticesPerCommand, VerticesPerSegment, Random);
+
+	const FTransform2D Transform{ FVector2D{ 10.f, 20.f } };
+	const FSlateRect ClippingRect{ 0.f, 0.f, 8192.f, 8192.f };
+
+	// Old path: convert all vertices, then for every command copy indices one by one, copy the vertex tail from the
+	// command vertex offset when it changes, and copy that tail again into the element (like MakeCustomVerts).
+	int64 OldNumCopiedVertices = 0;
+	const double OldStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		TArray<FSlateVertex> VertexBuffer;
+		VertexBuffer.SetNumUninitialized(Source.VtxBuffer.Size);
+		ImGuiVertexConversion::CopyScalar(VertexBuffer.GetData(), Source.VtxBuffer.Data, Source.VtxBuffer.Size, Transform);
+
+		TArray<SlateIndex> IndexBuffer;
+		TArray<FSlateVertex> OffsetVertexBuffer;
+		uint32 LastVertexOffset = INDEX_NONE;
+		int32 IndexBufferOffset = 0;
+		for (const ImDrawCmd& Command : Source.CmdBuffer)
+		{
+			IndexBuffer.SetNumUninitialized(Command.ElemCount, EAllowShrinking::No);
+			for (int32 Idx = 0; Idx < (int32)Command.ElemCount; Idx++)
+			{
+				IndexBuffer[Idx] = Source.IdxBuffer[IndexBufferOffset + Idx];
+			}
+			IndexBufferOffset += Command.ElemCount;
+
+			if (LastVertexOffset != Command.VtxOffset)
+			{
+				OffsetVertexBuffer = TArray<FSlateVertex>(VertexBuffer.GetData() + Command.VtxOffset, VertexBuffer.Num() - Command.VtxOffset);
+				LastVertexOffset = Command.VtxOffset;
+			}
+
+			const TArray<FSlateVertex> ElementVertices = OffsetVertexBuffer;
+			const TArray<SlateIndex> ElementIndices = IndexBuffer;
+			OldNumCopiedVertices += ElementVertices.Num();
+		}
+	}
+	const double OldTime = (FPlatformTime::Seconds() - OldStartTime) / NumIterations;
+
+	// New path: convert for Slate and batch commands like SImGuiWidget::OnPaint, copying only referenced vertices.
+	int64 NewNumCopiedVertices = 0;
+	const double NewStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		FImGuiSlateDrawList SlateDrawList;
+		DrawList.ConvertToSlate(SlateDrawList, Transform, ClippingRect);
+
+		FImGuiSlateDrawBatch Batch;
+		const auto FlushBatch = [&]()
+		{
+			const TArray<FSlateVertex> ElementVertices = Batch.Vertices;
+			const TArray<SlateIndex> ElementIndices = Batch.Indices;
+			NewNumCopiedVertices += ElementVertices.Num();
+			Batch.Reset();
+		};
+
+		for (const FImGuiSlateDrawCommand& Command : SlateDrawList.Commands)
+		{
+			if (!Batch.CanAdd(Command))
+			{
+				FlushBatch();
+			}
+
+			Batch.Add(SlateDrawList, Command);
+		}
+
+		FlushBatch();
+	}
+	const double NewTime = (FPlatformTime::Seconds() - NewStartTime) / NumIterations;
+
+	AddInfo(FString::Printf(TEXT("%d vertices, %d commands: old path %.3f ms (%lld vertices copied to elements), new path %.3f ms (%lld vertices copied to elements), speed-up %.1fx."),
+		NumVertices, Source.CmdBuffer.Size, OldTime * 1000.0, OldNumCopiedVertices / NumIterations, NewTime * 1000.0,
+		NewNumCopiedVertices / NumIterations, OldTime / FMath::Max(NewTime, 1e-9)));
+
+	// New path copies each visible vertex once per frame.
+	TestEqual(TEXT("Vertices copied to elements by new path"), NewNumCopiedVertices / NumIterations, (int64)(NumVertices - NumVertices % 3));
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiDrawDataIndexRebasingTest, "ImGui.DrawData.IndexRebasing",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiDrawDataIndexRebasingTest::RunTest(const FString& Parameters)
+{
+	using namespace ImGuiDrawDataTests;
+
+	// Small vertex offset segments, so commands have both non-zero vertex offsets and indices that don't start at zero.
+	FRandomStream Random{ 0x1A6E };
+	FImGuiDrawList DrawList;
+	ImDrawList Source{ nullptr };
+	MakeDrawList(DrawList, &Source, 10000, 99, 990, Random);
+
+	int32 NumBatches, MaxBatchVertices;
+	return TestIndexMapping(*this, DrawList, Source, NumBatches, MaxBatchVertices)
+		&& TestEqual(TEXT("Number of batches"), NumBatches, 1);
+}
+
+#if IMGUI_USE_32BIT_DRAW_INDICES
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiDrawData32BitIndicesTest, "ImGui.DrawData.Indices32Bit",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiDrawData32BitIndicesTest::RunTest(const FString& Parameters)
+{
+	using namespace ImGuiDrawDataTests;
+
+	static_assert(sizeof(ImDrawIdx) == 4, "IMGUI_USE_32BIT_DRAW_INDICES should configure 32-bit ImDrawIdx.");
+
+	// With 32-bit indices ImGui doesn't need vertex offsets, so all commands share one segment and a single command
+	// references more than 65535 vertices.
+	constexpr int32 NumVertices = 150000;
+	constexpr int32 VerticesPerCommand = 3 * 40000;
+
+	FRandomStream Random{ 0x1A6E };
+	FImGuiDrawList DrawList;
+	ImDrawList Source{ nullptr };
+	MakeDrawList(DrawList, &Source, NumVertices, VerticesPerCommand, 2 * VerticesPerCommand, Random);
+
+	int32 NumBatches, MaxBatchVertices;
+	return TestIndexMapping(*this, DrawList, Source, NumBatches, MaxBatchVertices)
+		&& TestEqual(TEXT("Number of batches"), NumBatches, 1)
+		&& TestEqual(TEXT("Number of vertices in batch"), MaxBatchVertices, NumVertices);
+}
+#else
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiDrawData16BitIndicesTest, "ImGui.DrawData.Indices16Bit",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiDrawData16BitIndicesTest::RunTest(const FString& Parameters)
+{
+	using namespace ImGuiDrawDataTests;
+
+	static_assert(sizeof(ImDrawIdx) == 2, "Without IMGUI_USE_32BIT_DRAW_INDICES, ImDrawIdx should stay 16-bit.");
+
+	// With 16-bit indices ImGui starts a new vertex offset segment before running out of index range. Segments here
+	// are as large as 16-bit indices allow, so conversion and batching need to handle more than 65535 vertices.
+	constexpr int32 NumVertices = 150000;
+	constexpr int32 VerticesPerCommand = 297;
+	constexpr int32 VerticesPerSegment = VerticesPerCommand * 220;
+	static_assert(VerticesPerSegment <= 65536, "Segment needs to be addressable with 16-bit indices.");
+
+	FRandomStream Random{ 0x1A6E };
+	FImGuiDrawList DrawList;
+	ImDrawList Source{ nullptr };
+	MakeDrawList(DrawList, &Source, NumVertices, VerticesPerCommand, VerticesPerSegment, Random);
+
+	int32 NumBatches, MaxBatchVertices;
+	if (!TestIndexMapping(*this, DrawList, Source, NumBatches, MaxBatchVertices))
+	{
+		return false;
+	}
+
+	// With 32-bit SlateIndex everything fits into one batch, otherwise batches need to split before 65536 vertices.
+	if (sizeof(SlateIndex) == 4)
+	{
+		return TestEqual(TEXT("Number of batches"), NumBatches, 1)
+			&& TestEqual(TEXT("Number of vertices in batch"), MaxBatchVertices, NumVertices - NumVertices % 3);
+	}
+	else
+	{
+		return TestTrue(TEXT("Batches split above 65535 vertices"), NumBatches >= 3 && MaxBatchVertices <= 65536);
+	}
+}
+#endif // IMGUI_USE_32BIT_DRAW_INDICES
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+#endif // WITH_DEV_AUTOMATION_TESTS
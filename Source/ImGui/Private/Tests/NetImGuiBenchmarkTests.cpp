@@ -0,0 +1,76 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "NetImGuiBenchmark.h"
+
+#include "ImGuiContextManager.h"
+#include "ImGuiModuleManager.h"
+
+#include <Misc/AutomationTest.h>
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Send synthetic frames through the NetImgui pipeline, with and without entropy coding, and check that every compressed
+// frame decompresses.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNetImGuiPipelineTest, "ImGui.NetImgui.Pipeline",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FNetImGuiPipelineTest::RunTest(const FString& Parameters)
+{
+	FImGuiModuleManager* ModuleManager = FImGuiModuleManager::Get();
+	if (!TestNotNull(TEXT("ImGui module manager"), ModuleManager))
+	{
+		return false;
+	}
+
+	for (const bool bEntropyCompression : { false, true })
+	{
+		NetImGuiBenchmark::FPipelineSettings Settings;
+		Settings.FrameCount = 30;
+		Settings.Iterations = 2;
+		Settings.bEntropyCompression = bEntropyCompression;
+
+		NetImGuiBenchmark::FPipelineResults Results;
+		const TCHAR* Mode = bEntropyCompression ? TEXT("entropy coding") : TEXT("delta compression");
+		if (!TestTrue(FString::Printf(TEXT("Pipeline completed with %s"), Mode),
+			NetImGuiBenchmark::RunPipeline(Settings, ModuleManager->GetContextManager().GetFontAtlas(), Results)))
+		{
+			continue;
+		}
+
+		TestEqual(FString::Printf(TEXT("Number of frames with %s"), Mode), Results.NumFrames, Settings.FrameCount);
+		TestEqual(FString::Printf(TEXT("Frames that failed to decompress with %s"), Mode), Results.NumDecodeErrors, 0);
+	}
+
+	return true;
+}
+
+// Compare delta compression of synthetic frame pairs with the block scan and with the reference implementation, which
+// must produce the same data and restore the new frame.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNetImGuiDeltaCompressionTest, "ImGui.NetImgui.DeltaCompression",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FNetImGuiDeltaCompressionTest::RunTest(const FString& Parameters)
+{
+	FImGuiModuleManager* ModuleManager = FImGuiModuleManager::Get();
+	if (!TestNotNull(TEXT("ImGui module manager"), ModuleManager))
+	{
+		return false;
+	}
+
+	NetImGuiBenchmark::FPipelineSettings Settings;
+	Settings.FrameCount = 30;
+	Settings.Iterations = 1;
+	Settings.bVerifyDeltaCompression = true;
+
+	NetImGuiBenchmark::FPipelineResults Results;
+	if (!TestTrue(TEXT("Pipeline completed"), NetImGuiBenchmark::RunPipeline(Settings, ModuleManager->GetContextManager().GetFontAtlas(), Results)))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Frame pairs different from the reference implementation"), Results.NumDeltaMismatches, 0);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
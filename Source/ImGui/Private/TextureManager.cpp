@@ -1,19 +1,97 @@
 // Distributed under the MIT License (MIT) (see accompanying LICENSE file)
 
 #include "TextureManager.h"
+
+#include "ImGuiImplementation.h"
+#include "ImGuiModuleDebug.h"
+
 #include <Engine/Texture2D.h>
 #include <Framework/Application/SlateApplication.h>
+#include <HAL/IConsoleManager.h>
+#include <Misc/ScopeLock.h>
 
 #include <algorithm>
+#include <imstb_rectpack.h>
 
 class UTexture;
 class UTexture2D;
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Texture Uploads"), STAT_ImGuiTextureUploads, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Texture Uploads Coalesced"), STAT_ImGuiTextureUploadsCoalesced, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Texture Upload Bytes"), STAT_ImGuiTextureUploadBytes, STATGROUP_ImGui);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Texture Upload Queue Depth"), STAT_ImGuiTextureUploadQueueDepth, STATGROUP_ImGui);
+DECLARE_MEMORY_STAT(TEXT("Texture Upload Queue Bytes"), STAT_ImGuiTextureUploadQueueBytes, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Texture Region Updates"), STAT_ImGuiTextureRegionUpdates, STATGROUP_ImGui);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Icon Atlas Icons"), STAT_ImGuiIconAtlasIcons, STATGROUP_ImGui);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Icon Atlas Pages"), STAT_ImGuiIconAtlasPages, STATGROUP_ImGui);
+DECLARE_MEMORY_STAT(TEXT("Texture Resident Bytes"), STAT_ImGuiTextureResidentBytes, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Texture Evictions"), STAT_ImGuiTextureEvictions, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Texture Reloads"), STAT_ImGuiTextureReloads, STATGROUP_ImGui);
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiTextureManager, Log, All);
+
+// Maximum number of released staging buffers kept for reuse.
+static constexpr int32 MAX_FREE_STAGING_BUFFERS = 16;
+
+// Size of icon atlas pages and padding around each icon.
+static constexpr int32 ICON_PAGE_SIZE = 512;
+static constexpr int32 ICON_PADDING = 1;
+
+// Get the rectangle of icon pixels from a packed rectangle, which includes padding.
+static FIntRect GetPackedIconRect(const stbrp_rect& Rect)
+{
+	return FIntRect(Rect.x + ICON_PADDING, Rect.y + ICON_PADDING, Rect.x + Rect.w - ICON_PADDING, Rect.y + Rect.h - ICON_PADDING);
+}
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> TextureUploadBudget(TEXT("ImGui.TextureUploadBudget"), 4096,
+		TEXT("Maximum size in KB of texture data uploaded per frame. Textures above the budget wait in a queue for the next\n")
+		TEXT("frames and are rendered with the error texture until uploaded. At least one texture is uploaded per frame.\n")
+		TEXT("0: unlimited"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> TextureMemoryBudget(TEXT("ImGui.TextureMemoryBudget"), 256,
+		TEXT("Maximum size in MB of textures created by ImGui. Above the budget, least recently used textures with a reload\n")
+		TEXT("callback are evicted and reloaded on the next use, which includes textures of NetImgui connections (resent by\n")
+		TEXT("the client). Other textures are pinned.\n")
+		TEXT("0: unlimited"),
+		ECVF_Default);
+}
+
+struct FTextureManager::FIconPage
+{
+	int32 Id = INDEX_NONE;
+	TextureIndex Index = INDEX_NONE;
+	stbrp_context Packer;
+	TArray<stbrp_node> Nodes;
+
+	int32 NumIcons = 0;
+};
+
+FTextureManager::FTextureManager()
+	: DumpTexturesCommand(TEXT("ImGui.DumpTextures"),
+		TEXT("Log memory used by ImGui textures, least recently used first."),
+		FConsoleCommandDelegate::CreateRaw(this, &FTextureManager::DumpTextures))
+{
+}
+
+FTextureManager::~FTextureManager() = default;
+
 void FTextureManager::InitializeErrorTexture(const FColor& Color)
 {
 	CreatePlainTextureInternal(NAME_ErrorTexture, 2, 2, Color);
 }
 
+void FTextureManager::Tick()
+{
+	ReloadTextures();
+	EvictTextures();
+
+	UploadedBytesThisFrame = 0;
+	ProcessUploadQueue();
+}
+
 TextureIndex FTextureManager::CreateTexture(const FName& Name, int32 Width, int32 Height, uint32 SrcBpp, uint8* SrcData, TFunction<void(uint8*)> SrcDataCleanup)
 {
 	checkf(Name != NAME_None, TEXT("Trying to create a texture with a name 'NAME_None' is not allowed."));
@@ -28,20 +106,277 @@ TextureIndex FTextureManager::CreatePlainTexture(const FName& Name, int32 Width,
 	return CreatePlainTextureInternal(Name, Width, Height, Color);
 }
 
+TextureIndex FTextureManager::CreateDynamicTexture(const FName& Name, int32 Width, int32 Height)
+{
+	return CreatePlainTexture(Name, Width, Height, FColor::Transparent);
+}
+
+bool FTextureManager::UpdateTextureRegion(TextureIndex Index, const FIntRect& Region, TArrayView<const FColor> Pixels)
+{
+	if (!IsValidTexture(Index))
+	{
+		return false;
+	}
+
+	const int32 Slot = GetSlot(Index);
+	UTexture2D* Texture = Cast<UTexture2D>(TextureResources[Slot].GetOwnedTexture());
+	if (Texture == nullptr)
+	{
+		return false;
+	}
+
+	if (Region.Min.X < 0 || Region.Min.Y < 0 || Region.Max.X > Texture->GetSizeX() || Region.Max.Y > Texture->GetSizeY()
+		|| Region.Width() <= 0 || Region.Height() <= 0 || Pixels.Num() < Region.Area())
+	{
+		return false;
+	}
+
+	// Initial data still waiting in the queue would overwrite this region.
+	FlushUpload(Slot);
+
+	const int32 Size = Region.Area() * sizeof(FColor);
+	TArray<uint8>* Buffer = StagingBuffers->Acquire(Size);
+	FMemory::Memcpy(Buffer->GetData(), Pixels.GetData(), Size);
+
+	FUpdateTextureRegion2D* TextureRegion = new FUpdateTextureRegion2D(Region.Min.X, Region.Min.Y, 0, 0, Region.Width(), Region.Height());
+	auto DataCleanup = [Pool = StagingBuffers, Buffer](uint8* Data, const FUpdateTextureRegion2D* UpdateRegion)
+	{
+		Pool->Release(Buffer);
+		delete UpdateRegion;
+	};
+	Texture->UpdateTextureRegions(0, 1u, TextureRegion, Region.Width() * sizeof(FColor), sizeof(FColor), Buffer->GetData(), DataCleanup);
+
+	// Region updates are not queued, but they use the budget of queued uploads.
+	UploadedBytesThisFrame += Size;
+	INC_DWORD_STAT(STAT_ImGuiTextureRegionUpdates);
+	INC_DWORD_STAT_BY(STAT_ImGuiTextureUploadBytes, Size);
+
+	return true;
+}
+
 TextureIndex FTextureManager::CreateTextureResources(const FName& Name, UTexture* Texture)
 {
 	checkf(Name != NAME_None, TEXT("Trying to create texture resources with a name 'NAME_None' is not allowed."));
 	checkf(Texture, TEXT("Null Texture."));
 
+	// Data queued for a texture previously created with that name are not needed anymore.
+	if (const int32* Slot = TextureSlots.Find(Name))
+	{
+		CancelUpload(*Slot);
+	}
+
 	// Create an entry for the texture.
 	return AddTextureEntry(Name, Texture, false);
 }
 
 void FTextureManager::ReleaseTextureResources(TextureIndex Index)
 {
-	checkf(IsInRange(Index), TEXT("Invalid texture index %d. Texture resources array has %d entries total."), Index, TextureResources.Num());
+	const int32 Slot = GetSlot(Index);
+	checkf(Index >= 0 && IsInRange(Slot), TEXT("Invalid texture index %d. Texture resources array has %d entries total."), Index, TextureResources.Num());
 
-	TextureResources[Index] = {};
+	if (IsValidTexture(Index))
+	{
+		CancelUpload(Slot);
+		ReloadCallbacks.Remove(Slot);
+		ReloadRequests.Remove(Slot);
+		TextureSlots.Remove(TextureResources[Slot].GetName());
+		TextureResources[Slot] = {};
+
+		// Invalidate indices to this texture, which may still be referenced by draw data, before the slot is reused.
+		SlotGenerations[Slot] = (SlotGenerations[Slot] + 1) & GenerationMask;
+		FreeSlots.Push(Slot);
+	}
+}
+
+bool FTextureManager::SetTextureReloadCallback(TextureIndex Index, FTextureReloadCallback ReloadCallback)
+{
+	if (!IsValidTexture(Index))
+	{
+		return false;
+	}
+
+	const int32 Slot = GetSlot(Index);
+	const FTextureEntry& Entry = TextureResources[Slot];
+	if (Entry.GetOwnedTexture() == nullptr && !Entry.IsEvicted())
+	{
+		return false;
+	}
+
+	ReloadCallbacks.Add(Slot, MoveTemp(ReloadCallback));
+	return true;
+}
+
+bool FTextureManager::AddIcon(const FName& Name, int32 Width, int32 Height, TArrayView<const FColor> Pixels, FIconLocation& OutLocation)
+{
+	checkf(Name != NAME_None, TEXT("Trying to add an icon with a name 'NAME_None' is not allowed."));
+
+	if (Width <= 0 || Height <= 0 || Width > MaxIconSize || Height > MaxIconSize || Pixels.Num() < Width * Height)
+	{
+		return false;
+	}
+
+	if (FIcon* Icon = Icons.Find(Name))
+	{
+		// Icon replaced with one of the same size keeps its location, so handles to it stay valid.
+		if (Icon->Rect.Width() == Width && Icon->Rect.Height() == Height)
+		{
+			UploadIcon(*Icon, Pixels);
+			OutLocation = GetIconLocation(*Icon);
+			return true;
+		}
+
+		ReleaseIcon(Name);
+	}
+
+	FIcon& Icon = Icons.Add(Name);
+	Icon.Rect = FIntRect(0, 0, Width, Height);
+	PlaceIcon(Icon, Pixels);
+	INC_DWORD_STAT(STAT_ImGuiIconAtlasIcons);
+
+	OutLocation = GetIconLocation(Icon);
+	return true;
+}
+
+bool FTextureManager::FindIcon(const FName& Name, FIconLocation& OutLocation) const
+{
+	if (const FIcon* Icon = Icons.Find(Name))
+	{
+		OutLocation = GetIconLocation(*Icon);
+		return true;
+	}
+	return false;
+}
+
+bool FTextureManager::ReleaseIcon(const FName& Name)
+{
+	FIcon Icon;
+	if (!Icons.RemoveAndCopyValue(Name, Icon))
+	{
+		return false;
+	}
+
+	DEC_DWORD_STAT(STAT_ImGuiIconAtlasIcons);
+
+	FIconPage& Page = *IconPages.FindChecked(Icon.Page);
+	Page.NumIcons--;
+
+	// Space is reclaimed only once all icons of a page are released, since icons never move and handles to them stay
+	// valid until they are released.
+	if (Page.NumIcons == 0)
+	{
+		ReleaseTextureResources(Page.Index);
+		IconPages.Remove(Icon.Page);
+		DEC_DWORD_STAT(STAT_ImGuiIconAtlasPages);
+	}
+
+	return true;
+}
+
+void FTextureManager::ReloadTextures()
+{
+	if (ReloadRequests.Num() == 0)
+	{
+		return;
+	}
+
+	// Callbacks create textures, so they work on a copy of requests and callbacks.
+	const TSet<int32> Requests = MoveTemp(ReloadRequests);
+	ReloadRequests.Reset();
+
+	for (const int32 Slot : Requests)
+	{
+		const FTextureReloadCallback* ReloadCallback = ReloadCallbacks.Find(Slot);
+		if (ReloadCallback && TextureResources[Slot].IsEvicted())
+		{
+			const FTextureReloadCallback Reload = *ReloadCallback;
+			Reload(TextureResources[Slot].GetName());
+			INC_DWORD_STAT(STAT_ImGuiTextureReloads);
+		}
+	}
+}
+
+void FTextureManager::EvictTextures()
+{
+	const uint64 Budget = static_cast<uint64>(FMath::Max(CVars::TextureMemoryBudget.GetValueOnGameThread(), 0)) * 1024 * 1024;
+
+	uint64 ResidentBytes = 0;
+	TArray<int32> EvictableSlots;
+	for (int32 Slot = 0; Slot < TextureResources.Num(); Slot++)
+	{
+		const FTextureEntry& Entry = TextureResources[Slot];
+		if (Entry.GetSize() > 0 && !Entry.IsEvicted())
+		{
+			ResidentBytes += Entry.GetSize();
+
+			// Textures used in the last frame are likely to be used again, so evicting them would only cause reloads.
+			if (Entry.GetLastUsedFrame() + 1 < GFrameCounter && ReloadCallbacks.Contains(Slot))
+			{
+				EvictableSlots.Add(Slot);
+			}
+		}
+	}
+
+	if (Budget > 0 && ResidentBytes > Budget)
+	{
+		EvictableSlots.Sort([this](int32 A, int32 B)
+		{
+			return TextureResources[A].GetLastUsedFrame() < TextureResources[B].GetLastUsedFrame();
+		});
+
+		for (int32 Index = 0; Index < EvictableSlots.Num() && ResidentBytes > Budget; Index++)
+		{
+			const int32 Slot = EvictableSlots[Index];
+			ResidentBytes -= TextureResources[Slot].GetSize();
+			CancelUpload(Slot);
+			TextureResources[Slot].Evict();
+			INC_DWORD_STAT(STAT_ImGuiTextureEvictions);
+		}
+	}
+
+	SET_MEMORY_STAT(STAT_ImGuiTextureResidentBytes, ResidentBytes);
+}
+
+void FTextureManager::DumpTextures() const
+{
+	TArray<int32> Slots;
+	uint64 ResidentBytes = 0;
+	int32 NumEvicted = 0;
+	for (int32 Slot = 0; Slot < TextureResources.Num(); Slot++)
+	{
+		const FTextureEntry& Entry = TextureResources[Slot];
+		if (Entry.GetName() != NAME_None)
+		{
+			Slots.Add(Slot);
+			if (Entry.IsEvicted())
+			{
+				NumEvicted++;
+			}
+			else
+			{
+				ResidentBytes += Entry.GetSize();
+			}
+		}
+	}
+
+	Slots.Sort([this](int32 A, int32 B)
+	{
+		return TextureResources[A].GetLastUsedFrame() < TextureResources[B].GetLastUsedFrame();
+	});
+
+	UE_LOG(LogImGuiTextureManager, Display, TEXT("ImGui textures: %d registered, %d evicted, %.2f MB resident, budget %d MB, %d icons in %d atlas pages."),
+		Slots.Num(), NumEvicted, ResidentBytes / (1024.f * 1024.f), CVars::TextureMemoryBudget.GetValueOnGameThread(), Icons.Num(), IconPages.Num());
+	UE_LOG(LogImGuiTextureManager, Display, TEXT("%6s %10s %10s  %-9s %s"), TEXT("Slot"), TEXT("Size KB"), TEXT("Unused"), TEXT("State"), TEXT("Name"));
+
+	for (const int32 Slot : Slots)
+	{
+		const FTextureEntry& Entry = TextureResources[Slot];
+		const TCHAR* State = Entry.IsEvicted() ? TEXT("Evicted")
+			: Entry.GetSize() == 0 ? TEXT("External")
+			: ReloadCallbacks.Contains(Slot) ? TEXT("Evictable")
+			: TEXT("Pinned");
+		UE_LOG(LogImGuiTextureManager, Display, TEXT("%6d %10.1f %10llu  %-9s %s%s"), Slot, Entry.GetSize() / 1024.f, GFrameCounter - Entry.GetLastUsedFrame(),
+			State, *Entry.GetName().ToString(), PendingUploads.Contains(Slot) ? TEXT(" (upload pending)") : TEXT(""));
+	}
 }
 
 TextureIndex FTextureManager::CreateTextureInternal(const FName& Name, int32 Width, int32 Height, uint32 SrcBpp, uint8* SrcData, TFunction<void(uint8*)> SrcDataCleanup)
@@ -52,24 +387,21 @@ TextureIndex FTextureManager::CreateTextureInternal(const FName& Name, int32 Wid
 	// Create a new resource for that texture.
 	Texture->UpdateResource();
 
-	// Update texture data.
-	FUpdateTextureRegion2D* TextureRegion = new FUpdateTextureRegion2D(0, 0, 0, 0, Width, Height);
-	auto DataCleanup = [SrcDataCleanup](uint8* Data, const FUpdateTextureRegion2D* UpdateRegion)
-	{
-		SrcDataCleanup(Data);
-		delete UpdateRegion;
-	};
-	Texture->UpdateTextureRegions(0, 1u, TextureRegion, SrcBpp * Width, SrcBpp, SrcData, DataCleanup);
+	// Texture data are uploaded later, to limit the size of uploads per frame.
+	FPendingUpload Upload{ Texture, Width, Height, SrcBpp, SrcData, MoveTemp(SrcDataCleanup) };
 
 	// Create an entry for the texture.
 	if (Name == NAME_ErrorTexture)
 	{
+		// Error texture is rendered in place of textures waiting for upload, so it is uploaded immediately.
+		Upload.Upload();
 		ErrorTexture = { Name, Texture, true };
 		return INDEX_ErrorTexture;
 	}
 	else
 	{
 		TextureIndex texIndex = AddTextureEntry(Name, Texture, true);
+		QueueUpload(GetSlot(texIndex), MoveTemp(Upload));
 		
 		// TODO only do this if we're running on the game server
 		// NetImgui::eTexFormat eFmt = SrcBpp == 1 ? NetImgui::eTexFormat::kTexFmtA8 :
@@ -99,31 +431,193 @@ TextureIndex FTextureManager::CreatePlainTextureInternal(const FName& Name, int3
 	return CreateTextureInternal(Name, Width, Height, Bpp, SrcData, SrcDataCleanup);
 }
 
-TextureIndex FTextureManager::AddTextureEntry(const FName& Name, UTexture* Texture, bool bAddToRoot)
+void FTextureManager::QueueUpload(int32 Slot, FPendingUpload&& Upload)
+{
+	PendingUploadBytes += Upload.GetSize();
+
+	if (FPendingUpload* PendingUpload = PendingUploads.Find(Slot))
+	{
+		// Texture was replaced before its data were uploaded, so only the new data need to be uploaded.
+		PendingUploadBytes -= PendingUpload->GetSize();
+		*PendingUpload = MoveTemp(Upload);
+		INC_DWORD_STAT(STAT_ImGuiTextureUploadsCoalesced);
+	}
+	else
+	{
+		PendingUploads.Add(Slot, MoveTemp(Upload));
+		UploadQueue.Add(Slot);
+	}
+
+	ProcessUploadQueue();
+}
+
+void FTextureManager::CancelUpload(int32 Slot)
+{
+	if (FPendingUpload* PendingUpload = PendingUploads.Find(Slot))
+	{
+		PendingUploadBytes -= PendingUpload->GetSize();
+		PendingUploads.Remove(Slot);
+		SET_DWORD_STAT(STAT_ImGuiTextureUploadQueueDepth, PendingUploads.Num());
+		SET_MEMORY_STAT(STAT_ImGuiTextureUploadQueueBytes, PendingUploadBytes);
+	}
+}
+
+void FTextureManager::FlushUpload(int32 Slot)
+{
+	if (FPendingUpload* PendingUpload = PendingUploads.Find(Slot))
+	{
+		const uint32 Size = PendingUpload->GetSize();
+		PendingUpload->Upload();
+		UploadedBytesThisFrame += Size;
+		INC_DWORD_STAT(STAT_ImGuiTextureUploads);
+		INC_DWORD_STAT_BY(STAT_ImGuiTextureUploadBytes, Size);
+
+		// Slot stays in the queue and is skipped when reached.
+		CancelUpload(Slot);
+	}
+}
+
+void FTextureManager::ProcessUploadQueue()
+{
+	const uint64 Budget = static_cast<uint64>(FMath::Max(CVars::TextureUploadBudget.GetValueOnGameThread(), 0)) * 1024;
+
+	int32 NumProcessed = 0;
+	for (; NumProcessed < UploadQueue.Num(); NumProcessed++)
+	{
+		const int32 Slot = UploadQueue[NumProcessed];
+		FPendingUpload* PendingUpload = PendingUploads.Find(Slot);
+		if (PendingUpload == nullptr)
+		{
+			continue;
+		}
+
+		// The first upload in a frame ignores the budget, so textures larger than the budget still get uploaded.
+		const uint32 Size = PendingUpload->GetSize();
+		if (Budget > 0 && UploadedBytesThisFrame > 0 && UploadedBytesThisFrame + Size > Budget)
+		{
+			break;
+		}
+
+		PendingUpload->Upload();
+		PendingUploads.Remove(Slot);
+		PendingUploadBytes -= Size;
+		UploadedBytesThisFrame += Size;
+
+		INC_DWORD_STAT(STAT_ImGuiTextureUploads);
+		INC_DWORD_STAT_BY(STAT_ImGuiTextureUploadBytes, Size);
+	}
+
+	UploadQueue.RemoveAt(0, NumProcessed, EAllowShrinking::No);
+	SET_DWORD_STAT(STAT_ImGuiTextureUploadQueueDepth, PendingUploads.Num());
+	SET_MEMORY_STAT(STAT_ImGuiTextureUploadQueueBytes, PendingUploadBytes);
+}
+
+void FTextureManager::PlaceIcon(FIcon& Icon, TArrayView<const FColor> Pixels)
 {
-	// Try to find an entry with that name.
-	TextureIndex Index = FindTextureIndex(Name);
+	for (auto& Page : IconPages)
+	{
+		if (PackIcon(*Page.Value, Icon, Pixels))
+		{
+			return;
+		}
+	}
+
+	TUniquePtr<FIconPage>& Page = IconPages.Add(NextIconPageId, MakeUnique<FIconPage>());
+	Page->Id = NextIconPageId++;
+	InitializeIconPage(*Page);
+	INC_DWORD_STAT(STAT_ImGuiIconAtlasPages);
+
+	verifyf(PackIcon(*Page, Icon, Pixels), TEXT("Icon of size %dx%d doesn't fit in an empty atlas page."), Icon.Rect.Width(), Icon.Rect.Height());
+}
+
+bool FTextureManager::PackIcon(FIconPage& Page, FIcon& Icon, TArrayView<const FColor> Pixels)
+{
+	stbrp_rect Rect{};
+	Rect.w = Icon.Rect.Width() + 2 * ICON_PADDING;
+	Rect.h = Icon.Rect.Height() + 2 * ICON_PADDING;
 
-	// If this is a new name, try to find an entry to reuse.
-	if (Index == INDEX_NONE)
+	if (!ImGuiImplementation::PackRects(&Page.Packer, &Rect, 1))
 	{
-		Index = FindTextureIndex(NAME_None);
+		return false;
 	}
 
-	// Either update/reuse an entry or add a new one.
-	if (Index != INDEX_NONE)
+	Icon.Page = Page.Id;
+	Icon.Rect = GetPackedIconRect(Rect);
+	Page.NumIcons++;
+	UploadIcon(Icon, Pixels);
+	return true;
+}
+
+void FTextureManager::InitializeIconPage(FIconPage& Page)
+{
+	const FName TextureName = *FString::Printf(TEXT("ImGuiIconAtlas_%d"), Page.Id);
+	Page.Index = CreateDynamicTexture(TextureName, ICON_PAGE_SIZE, ICON_PAGE_SIZE);
+
+	Page.Nodes.SetNumUninitialized(ICON_PAGE_SIZE);
+	ImGuiImplementation::InitRectPacker(&Page.Packer, ICON_PAGE_SIZE, ICON_PAGE_SIZE, Page.Nodes.GetData(), Page.Nodes.Num());
+}
+
+void FTextureManager::UploadIcon(const FIcon& Icon, TArrayView<const FColor> IconPixels)
+{
+	const int32 Width = Icon.Rect.Width();
+	const int32 Height = Icon.Rect.Height();
+	FIntRect Region = Icon.Rect;
+	Region.InflateRect(ICON_PADDING);
+
+	TArray<FColor> Pixels;
+	Pixels.SetNumUninitialized(Region.Area());
+	for (int32 Y = 0; Y < Region.Height(); Y++)
 	{
-		TextureResources[Index] = { Name, Texture, bAddToRoot };
-		return Index;
+		const int32 SrcY = FMath::Clamp(Y - ICON_PADDING, 0, Height - 1);
+		for (int32 X = 0; X < Region.Width(); X++)
+		{
+			const int32 SrcX = FMath::Clamp(X - ICON_PADDING, 0, Width - 1);
+			Pixels[Y * Region.Width() + X] = IconPixels[SrcY * Width + SrcX];
+		}
+	}
+
+	UpdateTextureRegion(IconPages.FindChecked(Icon.Page)->Index, Region, Pixels);
+}
+
+FTextureManager::FIconLocation FTextureManager::GetIconLocation(const FIcon& Icon) const
+{
+	FIconLocation Location;
+	Location.Index = IconPages.FindChecked(Icon.Page)->Index;
+	Location.UV0 = FVector2D(Icon.Rect.Min) / ICON_PAGE_SIZE;
+	Location.UV1 = FVector2D(Icon.Rect.Max) / ICON_PAGE_SIZE;
+	return Location;
+}
+
+TextureIndex FTextureManager::AddTextureEntry(const FName& Name, UTexture* Texture, bool bAddToRoot)
+{
+	// Update an entry with that name, keeping its index valid.
+	if (const int32* Slot = TextureSlots.Find(Name))
+	{
+		TextureResources[*Slot] = { Name, Texture, bAddToRoot };
+		return MakeTextureIndex(*Slot);
+	}
+
+	// Otherwise, reuse a released entry or add a new one.
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+		TextureResources[Slot] = { Name, Texture, bAddToRoot };
 	}
 	else
 	{
-		return TextureResources.Emplace(Name, Texture, bAddToRoot);
+		Slot = TextureResources.Emplace(Name, Texture, bAddToRoot);
+		SlotGenerations.Add(0);
+		checkf(Slot <= SlotMask, TEXT("Too many textures, indices support up to %d."), SlotMask + 1);
 	}
+
+	TextureSlots.Add(Name, Slot);
+	return MakeTextureIndex(Slot);
 }
 
 FTextureManager::FTextureEntry::FTextureEntry(const FName& InName, UTexture* InTexture, bool bAddToRoot)
 	: Name(InName)
+	, LastUsedFrame(GFrameCounter)
 {
 	checkf(InTexture, TEXT("Null texture."));
 
@@ -133,6 +627,12 @@ FTextureManager::FTextureEntry::FTextureEntry(const FName& InName, UTexture* InT
 		Texture = InTexture;
 		// Add texture to the root to prevent garbage collection.
 		InTexture->AddToRoot();
+
+		// Only textures that we own count towards the memory budget.
+		if (UTexture2D* Texture2D = Cast<UTexture2D>(InTexture))
+		{
+			Size = static_cast<uint64>(Texture2D->GetSizeX()) * Texture2D->GetSizeY() * GPixelFormats[Texture2D->GetPixelFormat()].BlockBytes;
+		}
 	}
 
 	// Create brush and resource handle for input texture.
@@ -152,6 +652,9 @@ FTextureManager::FTextureEntry& FTextureManager::FTextureEntry::operator=(FTextu
 
 	// Move data and ownership to this instance.
 	Name = MoveTemp(Other.Name);
+	Size = Other.Size;
+	LastUsedFrame = Other.LastUsedFrame;
+	bEvicted = Other.bEvicted;
 	Texture = MoveTemp(Other.Texture);
 	Brush = MoveTemp(Other.Brush);
 	CachedResourceHandle = MoveTemp(Other.CachedResourceHandle);
@@ -172,6 +675,20 @@ const FSlateResourceHandle& FTextureManager::FTextureEntry::GetResourceHandle()
 	return CachedResourceHandle;
 }
 
+void FTextureManager::FTextureEntry::Evict()
+{
+	const FName EvictedName = Name;
+	const uint64 EvictedSize = Size;
+	const uint64 EvictedLastUsedFrame = LastUsedFrame;
+
+	Reset(true);
+
+	Name = EvictedName;
+	Size = EvictedSize;
+	LastUsedFrame = EvictedLastUsedFrame;
+	bEvicted = true;
+}
+
 void FTextureManager::FTextureEntry::Reset(bool bReleaseResources)
 {
 	if (bReleaseResources)
@@ -192,9 +709,127 @@ void FTextureManager::FTextureEntry::Reset(bool bReleaseResources)
 
 	// We use empty name to mark unused entries.
 	Name = NAME_None;
+	Size = 0;
+	LastUsedFrame = 0;
+	bEvicted = false;
 
 	// Clean fields to make sure that we don't reference released or moved resources.
 	Texture.Reset();
 	Brush = FSlateNoResource();
 	CachedResourceHandle = FSlateResourceHandle();
 }
+
+FTextureManager::FPendingUpload::FPendingUpload(UTexture2D* InTexture, int32 InWidth, int32 InHeight, uint32 InSrcBpp, uint8* InSrcData,
+	TFunction<void(uint8*)> InSrcDataCleanup)
+	: Texture(InTexture)
+	, Width(InWidth)
+	, Height(InHeight)
+	, SrcBpp(InSrcBpp)
+	, SrcData(InSrcData)
+	, SrcDataCleanup(MoveTemp(InSrcDataCleanup))
+{
+}
+
+FTextureManager::FPendingUpload::~FPendingUpload()
+{
+	ReleaseData();
+}
+
+FTextureManager::FPendingUpload::FPendingUpload(FPendingUpload&& Other)
+{
+	*this = MoveTemp(Other);
+}
+
+FTextureManager::FPendingUpload& FTextureManager::FPendingUpload::operator=(FPendingUpload&& Other)
+{
+	if (this != &Other)
+	{
+		ReleaseData();
+
+		Texture = MoveTemp(Other.Texture);
+		Width = Other.Width;
+		Height = Other.Height;
+		SrcBpp = Other.SrcBpp;
+		SrcData = Other.SrcData;
+		SrcDataCleanup = MoveTemp(Other.SrcDataCleanup);
+
+		// Data ownership is moved to this instance.
+		Other.SrcData = nullptr;
+	}
+	return *this;
+}
+
+void FTextureManager::FPendingUpload::Upload()
+{
+	UTexture2D* TargetTexture = Texture.Get();
+	if (TargetTexture == nullptr || SrcData == nullptr)
+	{
+		ReleaseData();
+		return;
+	}
+
+	FUpdateTextureRegion2D* TextureRegion = new FUpdateTextureRegion2D(0, 0, 0, 0, Width, Height);
+	auto DataCleanup = [SrcDataCleanup = MoveTemp(SrcDataCleanup)](uint8* Data, const FUpdateTextureRegion2D* UpdateRegion)
+	{
+		SrcDataCleanup(Data);
+		delete UpdateRegion;
+	};
+	TargetTexture->UpdateTextureRegions(0, 1u, TextureRegion, SrcBpp * Width, SrcBpp, SrcData, DataCleanup);
+
+	// Render thread releases data after the upload.
+	SrcData = nullptr;
+}
+
+void FTextureManager::FPendingUpload::ReleaseData()
+{
+	if (SrcData)
+	{
+		SrcDataCleanup(SrcData);
+		SrcData = nullptr;
+	}
+}
+
+FTextureManager::FStagingBufferPool::~FStagingBufferPool()
+{
+	for (TArray<uint8>* Buffer : FreeBuffers)
+	{
+		delete Buffer;
+	}
+}
+
+TArray<uint8>* FTextureManager::FStagingBufferPool::Acquire(int32 Size)
+{
+	TArray<uint8>* Buffer = nullptr;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		// Prefer a buffer that doesn't need to grow, otherwise reuse the last released one.
+		const int32 FitIndex = FreeBuffers.IndexOfByPredicate([Size](const TArray<uint8>* Free) { return Free->Max() >= Size; });
+		const int32 Index = FitIndex != INDEX_NONE ? FitIndex : FreeBuffers.Num() - 1;
+		if (Index != INDEX_NONE)
+		{
+			Buffer = FreeBuffers[Index];
+			FreeBuffers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	if (Buffer == nullptr)
+	{
+		Buffer = new TArray<uint8>();
+	}
+	Buffer->SetNumUninitialized(Size, EAllowShrinking::No);
+	return Buffer;
+}
+
+void FTextureManager::FStagingBufferPool::Release(TArray<uint8>* Buffer)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (FreeBuffers.Num() < MAX_FREE_STAGING_BUFFERS)
+		{
+			FreeBuffers.Add(Buffer);
+			return;
+		}
+	}
+	delete Buffer;
+}
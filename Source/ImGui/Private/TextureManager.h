@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <CoreGlobals.h>
+#include <HAL/CriticalSection.h>
+#include <HAL/IConsoleManager.h>
 #include <Styling/SlateBrush.h>
 #include <Textures/SlateShaderResource.h>
 #include <UObject/WeakObjectPtr.h>
@@ -9,7 +12,8 @@
 
 class UTexture2D;
 
-// Index type to be used as a texture handle.
+// Index type to be used as a texture handle. Combines the slot of texture resources with a generation of that slot, so
+// indices of released textures don't reference textures created later in the same slot.
 using TextureIndex = int32;
 
 // Manager for textures resources which can be referenced by a unique name or index.
@@ -19,7 +23,10 @@ class FTextureManager
 public:
 
 	// Creates an empty manager.
-	FTextureManager() = default;
+	FTextureManager();
+
+	// Releases resources (defined in implementation, where icon pages are complete).
+	~FTextureManager();
 
 	// Copying is disabled to protected resource ownership.
 	FTextureManager(const FTextureManager&) = delete;
@@ -41,27 +48,66 @@ public:
 	// @returns The index of a texture with given name or INDEX_NONE if there is no such texture
 	TextureIndex FindTextureIndex(const FName& Name) const
 	{
-		return TextureResources.IndexOfByPredicate([&](const auto& Entry) { return Entry.GetName() == Name; });
+		const int32* Slot = TextureSlots.Find(Name);
+		return Slot ? MakeTextureIndex(*Slot) : INDEX_NONE;
 	}
 
-	// Get the name of a texture at given index. Returns NAME_None, if index is out of range.
+	// Get the name of a texture at given index. Returns NAME_None, if index is out of range or released.
 	// @param Index - Index of a texture
-	// @returns The name of a texture at given index or NAME_None if index is out of range.
+	// @returns The name of a texture at given index or NAME_None if index is out of range or released.
 	FName GetTextureName(TextureIndex Index) const
 	{
-		return IsInRange(Index) ? TextureResources[Index].GetName() : NAME_None;
+		return IsValidTexture(Index) ? TextureResources[GetSlot(Index)].GetName() : NAME_None;
 	}
 
-	// Get the Slate Resource Handle to a texture at given index. If index is out of range or resources are not valid
-	// it returns a handle to the error texture.
+	// Get the Slate Resource Handle to a texture at given index and mark that texture as used in the current frame. If
+	// index is out of range, released or resources are not valid it returns a handle to the error texture. Evicted
+	// textures are also rendered with the error texture, until they are reloaded in the next tick.
 	// @param Index - Index of a texture
 	// @returns The Slate Resource Handle for a texture at given index or to error texture, if no valid resources were
 	// found at given index
-	const FSlateResourceHandle& GetTextureHandle(TextureIndex Index) const
+	const FSlateResourceHandle& GetTextureHandle(TextureIndex Index)
+	{
+		if (IsValidTexture(Index))
+		{
+			const int32 Slot = GetSlot(Index);
+			FTextureEntry& Entry = TextureResources[Slot];
+			Entry.MarkUsed();
+
+			if (Entry.IsEvicted())
+			{
+				ReloadRequests.Add(Slot);
+			}
+			else if (IsTextureReady(Index))
+			{
+				return Entry.GetResourceHandle();
+			}
+		}
+		return ErrorTexture.GetResourceHandle();
+	}
+
+	// Check whether texture at given index is evicted and waits to be reloaded.
+	// @param Index - Index of a texture
+	// @returns True, if texture is valid and evicted
+	bool IsTextureEvicted(TextureIndex Index) const
 	{
-		return IsValidTexture(Index) ? TextureResources[Index].GetResourceHandle() : ErrorTexture.GetResourceHandle();
+		return IsValidTexture(Index) && TextureResources[GetSlot(Index)].IsEvicted();
 	}
 
+	// Check whether texture at given index has its data uploaded. Textures waiting in the upload queue are rendered
+	// with the error texture.
+	// @param Index - Index of a texture
+	// @returns True, if texture data are not waiting for upload
+	bool IsTextureReady(TextureIndex Index) const
+	{
+		return PendingUploads.Num() == 0 || !PendingUploads.Contains(GetSlot(Index));
+	}
+
+	// Start a new frame of texture uploads: reload evicted textures that were used since the last tick, evict least
+	// recently used textures above the memory budget, reset the per-frame upload budget and upload queued textures, as
+	// long as the budget allows it.
+	void Tick();
+
 	// Create a texture from raw data.
 	// @param Name - The texture name
 	// @param Width - The texture width
@@ -80,16 +126,76 @@ public:
 	// @returns The index of a texture that was created
 	TextureIndex CreatePlainTexture(const FName& Name, int32 Width, int32 Height, FColor Color);
 
+	// Create a dynamic texture, initially transparent, which content can be updated by regions.
+	// @param Name - The texture name
+	// @param Width - The texture width
+	// @param Height - The texture height
+	// @returns The index of a texture that was created
+	TextureIndex CreateDynamicTexture(const FName& Name, int32 Width, int32 Height);
+
+	// Update a region of a texture created by this manager, without recreating it, so its index stays valid. Pixels
+	// are copied to a pooled staging buffer and can be released after the call. Regions updated in the same frame are
+	// uploaded in the order of calls.
+	// @param Index - Index of a texture
+	// @param Region - Region of the texture to update, in pixels
+	// @param Pixels - Pixels of the region, row after row
+	// @returns True, if update was queued, false if texture is not valid or was not created by this manager, or if
+	// region is not inside the texture or is larger than the data
+	bool UpdateTextureRegion(TextureIndex Index, const FIntRect& Region, TArrayView<const FColor> Pixels);
+
 	// Create Slate resources to an existing texture, managed externally.
 	// @param Name - The texture name
 	// @param Texture - The texture
 	// @returns The index to created/updated texture resources
 	TextureIndex CreateTextureResources(const FName& Name, UTexture* Texture);
 
-	// Release resources for given texture. Ignores invalid indices.
+	// Release resources for given texture. Ignores indices of textures that are already released.
 	// @param Index - The index of a texture resources
 	void ReleaseTextureResources(TextureIndex Index);
 
+	// Callback that re-creates an evicted texture with the same name, which keeps its index valid.
+	using FTextureReloadCallback = TFunction<void(const FName&)>;
+
+	// Make a texture created by this manager evictable, when textures created by this manager exceed the memory budget.
+	// Textures without a reload callback are pinned. Callback is called in the tick following the first use of an
+	// evicted texture and can also re-create it later (until then, texture is rendered with the error texture).
+	// @param Index - Index of a texture
+	// @param ReloadCallback - Callback re-creating the texture
+	// @returns True, if callback was set, false if texture is not valid or was not created by this manager
+	bool SetTextureReloadCallback(TextureIndex Index, FTextureReloadCallback ReloadCallback);
+
+	// Location of an icon in the atlas: texture of its page and sub-rect of that texture.
+	struct FIconLocation
+	{
+		TextureIndex Index = INDEX_NONE;
+		FVector2D UV0 = FVector2D::ZeroVector;
+		FVector2D UV1 = FVector2D::UnitVector;
+	};
+
+	// Maximum width and height of icons packed in the atlas.
+	static constexpr int32 MaxIconSize = 64;
+
+	// Add an icon to the atlas, where it is packed with other icons into a shared page texture, so ImGui can draw them
+	// in one batch. Icon with the same name is replaced, keeping its location if it has the same size.
+	// @param Name - The icon name
+	// @param Width - The icon width, up to MaxIconSize
+	// @param Height - The icon height, up to MaxIconSize
+	// @param Pixels - Pixels of the icon, row after row (copied, so they can be released after the call)
+	// @param OutLocation - Location of the icon in the atlas
+	// @returns True, if icon was added, false if it is too large or pixels don't cover it
+	bool AddIcon(const FName& Name, int32 Width, int32 Height, TArrayView<const FColor> Pixels, FIconLocation& OutLocation);
+
+	// Find an icon by name. Icons keep their location until they are released or replaced by an icon of a different size.
+	// @param Name - The icon name
+	// @param OutLocation - Location of the icon in the atlas
+	// @returns True, if icon was found
+	bool FindIcon(const FName& Name, FIconLocation& OutLocation) const;
+
+	// Release an icon. Pages are released once all their icons are released, which reclaims their space.
+	// @param Name - The icon name
+	// @returns True, if icon was found and released
+	bool ReleaseIcon(const FName& Name);
+
 private:
 
 	// See CreateTexture for general description.
@@ -102,6 +208,107 @@ private:
 	// (aka NAME_None) and INDEX_ErrorTexture (aka INDEX_NONE) to identify ErrorTexture.
 	TextureIndex CreatePlainTextureInternal(const FName& Name, int32 Width, int32 Height, const FColor& Color);
 
+	// Pixel data waiting to be uploaded to a texture. Releases data that were not uploaded.
+	struct FPendingUpload
+	{
+		FPendingUpload(UTexture2D* InTexture, int32 InWidth, int32 InHeight, uint32 InSrcBpp, uint8* InSrcData, TFunction<void(uint8*)> InSrcDataCleanup);
+		~FPendingUpload();
+
+		FPendingUpload(const FPendingUpload&) = delete;
+		FPendingUpload& operator=(const FPendingUpload&) = delete;
+
+		FPendingUpload(FPendingUpload&& Other);
+		FPendingUpload& operator=(FPendingUpload&& Other);
+
+		uint32 GetSize() const { return Width * Height * SrcBpp; }
+
+		// Enqueue upload of the data to the texture on the render thread, which takes the ownership of the data.
+		void Upload();
+
+	private:
+
+		void ReleaseData();
+
+		TWeakObjectPtr<UTexture2D> Texture;
+		int32 Width = 0;
+		int32 Height = 0;
+		uint32 SrcBpp = 0;
+		uint8* SrcData = nullptr;
+		TFunction<void(uint8*)> SrcDataCleanup;
+	};
+
+	// Buffers for pixel data of region updates, returned to the pool by the render thread once data are uploaded.
+	// Shared with pending render commands, so it can outlive the manager.
+	class FStagingBufferPool
+	{
+	public:
+
+		~FStagingBufferPool();
+
+		// Get a buffer of given size, reusing a released one when possible.
+		TArray<uint8>* Acquire(int32 Size);
+
+		// Return a buffer to the pool (can be called from any thread).
+		void Release(TArray<uint8>* Buffer);
+
+	private:
+
+		FCriticalSection Lock;
+		TArray<TArray<uint8>*> FreeBuffers;
+	};
+
+	// Call reload callbacks of evicted textures used since the last tick.
+	void ReloadTextures();
+
+	// Evict least recently used textures with reload callbacks, until textures created by this manager fit in the
+	// memory budget. Textures used in the last frame are not evicted.
+	void EvictTextures();
+
+	// Log memory used by textures, least recently used first.
+	void DumpTextures() const;
+
+	// Add data to the upload queue, replacing data that are still waiting for upload to the same slot, and upload
+	// what fits in the budget of the current frame.
+	// @param Slot - The slot of the texture
+	// @param Upload - The data to upload
+	void QueueUpload(int32 Slot, FPendingUpload&& Upload);
+
+	// Remove data waiting for upload to a slot, if any.
+	void CancelUpload(int32 Slot);
+
+	// Upload data waiting for upload to a slot, if any, ignoring the budget.
+	void FlushUpload(int32 Slot);
+
+	// Upload textures from the front of the queue, while the budget of the current frame allows it.
+	void ProcessUploadQueue();
+
+	// Page of the icon atlas, with rectangle packer state (defined in implementation).
+	struct FIconPage;
+
+	// Icon packed in a page. Icons never move, so their locations stay valid until they are released.
+	struct FIcon
+	{
+		int32 Page = INDEX_NONE;
+		FIntRect Rect;
+	};
+
+	// Pack an icon in a page of the atlas, adding a new page if it doesn't fit in existing ones.
+	// @param Icon - The icon to place
+	// @param Pixels - Pixels of the icon, row after row
+	void PlaceIcon(FIcon& Icon, TArrayView<const FColor> Pixels);
+
+	// Pack an icon in a page and upload it.
+	// @returns True, if icon fits in the page
+	bool PackIcon(FIconPage& Page, FIcon& Icon, TArrayView<const FColor> Pixels);
+
+	// Create a texture for a new page and initialize its packer.
+	void InitializeIconPage(FIconPage& Page);
+
+	// Upload icon pixels to its page, with edges extruded into padding, so filtering doesn't sample neighbours.
+	void UploadIcon(const FIcon& Icon, TArrayView<const FColor> IconPixels);
+
+	FIconLocation GetIconLocation(const FIcon& Icon) const;
+
 	// Add or reuse texture entry.
 	// @param Name - The texture name
 	// @param Texture - The texture
@@ -109,16 +316,33 @@ private:
 	// @returns The index of the entry that we created or reused
 	TextureIndex AddTextureEntry(const FName& Name, UTexture* Texture, bool bAddToRoot);
 
-	// Check whether index is in range allocated for TextureResources (it doesn't mean that resources are valid).
-	FORCEINLINE bool IsInRange(TextureIndex Index) const
+	// Index layout: slot in the lower bits and generation above it. Sign bit is never set, so valid indices don't
+	// collide with INDEX_NONE. Generations wrap around after GenerationMask releases of the same slot.
+	static constexpr int32 SlotBits = 20;
+	static constexpr int32 SlotMask = (1 << SlotBits) - 1;
+	static constexpr int32 GenerationMask = (1 << (31 - SlotBits)) - 1;
+
+	FORCEINLINE static int32 GetSlot(TextureIndex Index) { return Index & SlotMask; }
+	FORCEINLINE static int32 GetGeneration(TextureIndex Index) { return (Index >> SlotBits) & GenerationMask; }
+
+	FORCEINLINE TextureIndex MakeTextureIndex(int32 Slot) const
 	{
-		return static_cast<uint32>(Index) < static_cast<uint32>(TextureResources.Num());
+		return (static_cast<int32>(SlotGenerations[Slot]) << SlotBits) | Slot;
 	}
 
-	// Check whether index is in range and whether texture resources are valid (using NAME_None sentinel).
+	// Check whether slot is in range allocated for TextureResources (it doesn't mean that resources are valid).
+	FORCEINLINE bool IsInRange(int32 Slot) const
+	{
+		return static_cast<uint32>(Slot) < static_cast<uint32>(TextureResources.Num());
+	}
+
+	// Check whether index is in range, whether it is from the current generation of its slot and whether texture
+	// resources are valid (using NAME_None sentinel).
 	FORCEINLINE bool IsValidTexture(TextureIndex Index) const
 	{
-		return IsInRange(Index) && TextureResources[Index].GetName() != NAME_None;
+		const int32 Slot = GetSlot(Index);
+		return Index >= 0 && IsInRange(Slot) && SlotGenerations[Slot] == GetGeneration(Index)
+			&& TextureResources[Slot].GetName() != NAME_None;
 	}
 
 	// Entry for texture resources. Only supports explicit construction.
@@ -140,11 +364,28 @@ private:
 		const FName& GetName() const { return Name; }
 		const FSlateResourceHandle& GetResourceHandle() const;
 
+		// Get the texture, if it is owned by this entry (added to root).
+		UTexture* GetOwnedTexture() const { return Texture.Get(); }
+
+		// Get the size in bytes of the texture owned by this entry (0 for textures managed externally).
+		uint64 GetSize() const { return Size; }
+
+		uint64 GetLastUsedFrame() const { return LastUsedFrame; }
+		void MarkUsed() { LastUsedFrame = GFrameCounter; }
+
+		// Release the owned texture, but keep the name, so the entry and indices to it stay valid until the texture
+		// is re-created.
+		void Evict();
+		bool IsEvicted() const { return bEvicted; }
+
 	private:
 
 		void Reset(bool bReleaseResources);
 
 		FName Name = NAME_None;
+		uint64 Size = 0;
+		uint64 LastUsedFrame = 0;
+		bool bEvicted = false;
 		mutable FSlateResourceHandle CachedResourceHandle;
 		TWeakObjectPtr<UTexture> Texture;
 		FSlateBrush Brush;
@@ -153,6 +394,32 @@ private:
 	TArray<FTextureEntry> TextureResources;
 	FTextureEntry ErrorTexture;
 
+	// Generation of each slot in TextureResources, incremented when a texture is released.
+	TArray<uint16> SlotGenerations;
+
+	// Slots of registered textures by name and released slots available for reuse.
+	TMap<FName, int32> TextureSlots;
+	TArray<int32> FreeSlots;
+
+	// Data waiting for upload by slot and slots in upload order (slots of cancelled uploads are skipped).
+	TMap<int32, FPendingUpload> PendingUploads;
+	TArray<int32> UploadQueue;
+	uint64 PendingUploadBytes = 0;
+	uint64 UploadedBytesThisFrame = 0;
+
+	// Pages of the icon atlas by id and icons by name.
+	TMap<int32, TUniquePtr<FIconPage>> IconPages;
+	TMap<FName, FIcon> Icons;
+	int32 NextIconPageId = 0;
+
+	TSharedRef<FStagingBufferPool, ESPMode::ThreadSafe> StagingBuffers = MakeShared<FStagingBufferPool, ESPMode::ThreadSafe>();
+
+	// Reload callbacks of evictable textures by slot and slots of evicted textures used since the last tick.
+	TMap<int32, FTextureReloadCallback> ReloadCallbacks;
+	TSet<int32> ReloadRequests;
+
+	FAutoConsoleCommand DumpTexturesCommand;
+
 	static constexpr EName NAME_ErrorTexture = NAME_None;
 	static constexpr TextureIndex INDEX_ErrorTexture = INDEX_NONE;
 };
@@ -757,6 +757,38 @@ FVector2D SImGuiWidget::TransformScreenPointToImGui(const FGeometry& MyGeometry,
 int32 SImGuiWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect,
 	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& WidgetStyle, bool bParentEnabled) const
 {
+	NumDrawCommands = 0;
+	NumDrawElements = 0;
+
+	// Consecutive commands with the same texture and clipping are merged into one batch and submitted as a single Slate
+	// element.
+	const auto FlushBatch = [&]()
+	{
+		if (!Batch.IsEmpty())
+		{
+			// Get texture resource handle for this batch (null index will be also mapped to a valid texture).
+			const FSlateResourceHandle& Handle = ModuleManager->GetTextureManager().GetTextureHandle(Batch.TextureId);
+
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+			// Get access to the Slate scissor rectangle defined in Slate Core API, so we can customize elements drawing.
+			extern SLATECORE_API TOptional<FShortRect> GSlateScissorRect;
+			TGuardValue<TOptional<FShortRect>> GSlateScissorRecGuard(GSlateScissorRect, FShortRect{ Batch.ClippingRect });
+#else
+			OutDrawElements.PushClip(FSlateClippingZone{ Batch.ClippingRect });
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+			// Add elements to the list.
+			FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, Handle, Batch.Vertices, Batch.Indices, nullptr, 0, 0);
+			NumDrawElements++;
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+			OutDrawElements.PopClip();
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+		}
+
+		Batch.Reset();
+	};
+
 	// iterate this in reverse order so the input priority matches draw order
 	for (int32 i = ContextIndexes.Num() - 1; i >= 0; --i)
 	{
@@ -777,62 +809,25 @@ int32 SImGuiWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeo
 			const FSlateRenderTransform& WidgetToScreen = AllottedGeometry.GetAccumulatedRenderTransform();
 			const FSlateRenderTransform ImGuiToScreen = RoundTranslation(ImGuiRenderTransform.Concatenate(WidgetToScreen));
 
-#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-			// Convert clipping rectangle to format required by Slate vertex.
-			const FSlateRotatedRect VertexClippingRect{ MyClippingRect };
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-
-			for (const auto& DrawList : ContextProxy->GetDrawData())
+			for (const FImGuiSlateDrawList& DrawList : ContextProxy->GetSlateDrawData(ImGuiToScreen, MyClippingRect))
 			{
-#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-				DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen, VertexClippingRect);
-#else
-				DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen);
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-
-				int IndexBufferOffset = 0;
-				uint32 LastVertexOffset = INDEX_NONE;
-				TArray<FSlateVertex> OffsetVertexBuffer; // Can't use TArrayView because FSlateDrawElement::MakeCustomVerts() takes a const TArray<>&
-				for (int CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
+				for (const FImGuiSlateDrawCommand& DrawCommand : DrawList.Commands)
 				{
-					const FImGuiDrawCommand& DrawCommand = DrawList.GetCommand(CommandNb, ImGuiToScreen);
+					NumDrawCommands++;
 
-					DrawList.CopyIndexData(IndexBuffer, IndexBufferOffset, DrawCommand.NumElements);
-
-					if (LastVertexOffset != DrawCommand.VertexOffset)
+					if (!Batch.CanAdd(DrawCommand))
 					{
-						auto VertexBufferSlice = TArrayView<FSlateVertex>(VertexBuffer.GetData() + DrawCommand.VertexOffset, VertexBuffer.Num() - DrawCommand.VertexOffset);
-						OffsetVertexBuffer = TArray<FSlateVertex>(VertexBufferSlice);
+						FlushBatch();
 					}
 
-					// Advance offset by number of copied elements to position it for the next command.
-					IndexBufferOffset += DrawCommand.NumElements;
-
-					// Get texture resource handle for this draw command (null index will be also mapped to a valid texture).
-					const FSlateResourceHandle& Handle = ModuleManager->GetTextureManager().GetTextureHandle(DrawCommand.TextureId);
-
-					// Transform clipping rectangle to screen space and apply to elements that we draw.
-					const FSlateRect ClippingRect = DrawCommand.ClippingRect.IntersectionWith(MyClippingRect);
-
-#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-					// Get access to the Slate scissor rectangle defined in Slate Core API, so we can customize elements drawing.
-					extern SLATECORE_API TOptional<FShortRect> GSlateScissorRect;
-					TGuardValue<TOptional<FShortRect>> GSlateScissorRecGuard(GSlateScissorRect, FShortRect{ ClippingRect });
-#else
-					OutDrawElements.PushClip(FSlateClippingZone{ ClippingRect });
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-
-					// Add elements to the list.
-					FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, Handle, OffsetVertexBuffer, IndexBuffer, nullptr, 0, 0);
-
-#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-					OutDrawElements.PopClip();
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+					Batch.Add(DrawList, DrawCommand);
 				}
 			}
 		}
 	}
 
+	FlushBatch();
+
 	return Super::OnPaint(Args, AllottedGeometry, MyClippingRect, OutDrawElements, LayerId, WidgetStyle, bParentEnabled);
 }
 
@@ -1024,6 +1019,12 @@ void SImGuiWidget::OnDebugDraw()
 				TwoColumns::Value("Input Enabled", bInputEnabled);
 			});
 
+			TwoColumns::CollapsingGroup("Rendering", [&]()
+			{
+				TwoColumns::Value("Draw Commands", NumDrawCommands);
+				TwoColumns::Value("Draw Elements", NumDrawElements);
+			});
+
 			TwoColumns::CollapsingGroup("Widget", [&]()
 			{
 				TwoColumns::Value("Visibility", *GetVisibility().ToString());
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ImGuiDrawData.h"
 #include "ImGuiModuleDebug.h"
 #include "ImGuiModuleSettings.h"
 
@@ -135,8 +136,12 @@ private:
 	FSlateRenderTransform ImGuiTransform;
 	FSlateRenderTransform ImGuiRenderTransform;
 
-	mutable TArray<FSlateVertex> VertexBuffer;
-	mutable TArray<SlateIndex> IndexBuffer;
+	// Batched data submitted to Slate as a single element.
+	mutable FImGuiSlateDrawBatch Batch;
+
+	// Number of ImGui draw commands and Slate elements in the last paint (to see effects of batching).
+	mutable int32 NumDrawCommands = 0;
+	mutable int32 NumDrawElements = 0;
 
 	TArray<int32> ContextIndexes;
 	TArray<TWeakObjectPtr<UImGuiInputHandler>> InputHandlers;
@@ -87,7 +87,7 @@ public:
 #endif // #if IMGUI_WITH_OBSOLETE_DELEGATES
 
 	/**
-	 * If it exists, get a handle to the texture with given resource name.
+	 * If it exists, get a handle to the texture or icon with given resource name.
 	 *
 	 * @param Name - Resource name of a texture to find
 	 * @returns Handle to a registered texture or invalid handle if resources could not be found or were not valid
@@ -111,6 +111,65 @@ public:
 	 */
 	virtual FImGuiTextureHandle RegisterTexture(const FName& Name, class UTexture* Texture, bool bMakeUnique = false);
 
+	/**
+	 * Create a dynamic texture, initially transparent, which content can be updated by regions with UpdateTextureRegion.
+	 * It is meant for live visualizations (e.g. heatmaps), which would otherwise need to create a new texture in each
+	 * frame. If texture with that name already exists, it is replaced. Throws exception, if name argument is NAME_None.
+	 * Release it with ReleaseTexture.
+	 *
+	 * @param Name - Resource name for the texture
+	 * @param Width - Width of the texture in pixels
+	 * @param Height - Height of the texture in pixels
+	 * @returns Handle to the texture resources, which stays valid when regions are updated
+	 */
+	virtual FImGuiTextureHandle CreateDynamicTexture(const FName& Name, int32 Width, int32 Height);
+
+	/**
+	 * Update a region of a dynamic texture (or any texture created by this module, but not registered textures).
+	 * Pixels are copied, so they can be released after the call. Several regions can be updated in one frame and are
+	 * uploaded in the order of calls.
+	 *
+	 * @param Handle - Handle to the texture
+	 * @param Region - Region of the texture to update, in pixels
+	 * @param Pixels - Pixels of the region, row after row
+	 * @returns True, if the region update was queued, false if handle is not valid, texture was not created by this
+	 *     module or region is outside of the texture or larger than pixel data
+	 */
+	virtual bool UpdateTextureRegion(const FImGuiTextureHandle& Handle, const FIntRect& Region, TArrayView<const FColor> Pixels);
+
+	/**
+	 * Make a texture created by this module evictable. Textures created by the module are kept in memory until they are
+	 * released, unless they exceed the memory budget (ImGui.TextureMemoryBudget). Then least recently drawn textures with
+	 * a reload callback are evicted. Textures without a reload callback are pinned.
+	 *
+	 * When an evicted texture is drawn again, the callback is called in the next tick. It should re-create the texture
+	 * with the same name (e.g. with CreateDynamicTexture and UpdateTextureRegion), which keeps existing handles valid.
+	 * Until then, the texture is drawn with the error texture. Use ImGui.DumpTextures to log texture memory usage.
+	 *
+	 * @param Handle - Handle to the texture
+	 * @param ReloadCallback - Callback re-creating the texture, called with its name
+	 * @returns True, if callback was set, false if handle is not valid or texture was not created by this module
+	 */
+	virtual bool SetTextureReloadCallback(const FImGuiTextureHandle& Handle, TFunction<void(const FName&)> ReloadCallback);
+
+	/**
+	 * Register a small texture, like an icon, in the icon atlas. Icons are packed into shared atlas pages and their
+	 * handles carry texture coordinates of their sub-rect (GetUV0 and GetUV1), so ImGui can draw many icons without
+	 * breaking batches. Icons larger than the atlas limit get their own dynamic texture with full texture coordinates.
+	 * If icon with that name already exists, it is replaced. Throws exception, if name argument is NAME_None.
+	 *
+	 * Icons never move, so their handles stay valid until they are released (with ReleaseTexture) or replaced by an icon
+	 * of a different size. Atlas pages are released once all their icons are released.
+	 *
+	 * @param Name - Resource name for the icon
+	 * @param Width - Width of the icon in pixels
+	 * @param Height - Height of the icon in pixels
+	 * @param Pixels - Pixels of the icon, row after row (copied, so they can be released after the call)
+	 * @returns Handle to the icon, which should be used with its texture coordinates, or null handle if pixels don't
+	 *     cover the icon
+	 */
+	virtual FImGuiTextureHandle RegisterIcon(const FName& Name, int32 Width, int32 Height, TArrayView<const FColor> Pixels);
+
 	/**
 	 * Unregister texture and release its Slate resources. If handle is null or not valid, this function fails silently
 	 * (for definition of 'valid' look @ FImGuiTextureHandle).
@@ -121,6 +180,13 @@ public:
 
 	virtual void RebuildFontAtlas();
 
+	/**
+	 * Request all ImGui contexts to be updated in the next frame. When idle frame skipping is enabled, contexts without
+	 * input skip frames and keep presenting their last output. Controls that show live values can call this every time
+	 * they are drawn, to keep their context updated.
+	 */
+	virtual void RequestRedraw();
+
 	/**
 	 * Get ImGui module properties.
 	 *
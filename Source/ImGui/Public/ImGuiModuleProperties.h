@@ -73,6 +73,30 @@ public:
 	/** Toggle ImGui demo. */
 	void ToggleDemo() { SetShowDemo(!ShowDemo()); }
 
+	/** Get the default maximum rate in Hz at which contexts are updated. Zero means that contexts update every frame. */
+	float GetMaxUpdateRate() const { return MaxUpdateRate; }
+
+	/**
+	 * Set the default maximum rate in Hz at which contexts are updated. Zero means that contexts update every frame.
+	 * Only module delegates are throttled. Widgets drawn outside of delegates (e.g. from an actor tick) are discarded
+	 * in frames that are not updated, so they should be drawn from delegates when throttling is enabled.
+	 * Contexts with active items or input are not throttled.
+	 */
+	void SetMaxUpdateRate(float Rate) { MaxUpdateRate = FMath::Max(Rate, 0.f); }
+
+	/** Get the maximum update rate in Hz for the context with given name (e.g. 'Editor', 'Game' or 'PIEContext1'). */
+	float GetContextMaxUpdateRate(const FString& ContextName) const
+	{
+		const float* Rate = ContextMaxUpdateRates.Find(ContextName);
+		return Rate ? *Rate : MaxUpdateRate;
+	}
+
+	/** Set the maximum update rate in Hz for the context with given name, overriding the default rate. */
+	void SetContextMaxUpdateRate(const FString& ContextName, float Rate) { ContextMaxUpdateRates.Add(ContextName, FMath::Max(Rate, 0.f)); }
+
+	/** Remove the maximum update rate override for the context with given name. */
+	void ResetContextMaxUpdateRate(const FString& ContextName) { ContextMaxUpdateRates.Remove(ContextName); }
+
 	/** Adds a new font to initialize */
 	void AddCustomFont(FName FontName, TSharedPtr<ImFontConfig> Font) { CustomFonts.Emplace(FontName, Font); }
 
@@ -101,6 +125,9 @@ private:
 
 	bool bShowDemo = false;
 
+	float MaxUpdateRate = 0.f;
+	TMap<FString, float> ContextMaxUpdateRates;
+
 	TMap<FName, TSharedPtr<ImFontConfig>> CustomFonts;
 
 	TSharedPtr<ImGuiStyle> DefaultStyle;
@@ -10,7 +10,8 @@ enum class EImGuiNetDrawContext
 
 class FImGuiContextManager;
 class FImGuiContextProxy;
-struct ImDrawData;
+class IConsoleObject;
+struct FImGuiRemoteDrawData;
 struct FImguiServerState;
 
 class FImGuiNetControl
@@ -27,6 +28,10 @@ public:
 	// Determines if there is an active Netimgui connection.
 	bool IMGUI_API IsConnected();
 
+	// Maximum number of game servers that can be viewed at the same time. Each connection is bound to the context
+	// of the client world that opened it.
+	static constexpr int32 MaxServerConnections = 16;
+
 public:
 	~FImGuiNetControl();
 
@@ -36,16 +41,37 @@ public:
 	bool IsConnected(int32 InContextIndex);
 	void Disconnect(int32 InContextIndex);
 	void ServerCaptureInput(int32 ContextIndex);
-	TUniquePtr<ImDrawData> GetServerDrawData(int32 ContextIndex);
+	TSharedPtr<const FImGuiRemoteDrawData, ESPMode::ThreadSafe> GetServerDrawData(int32 ContextIndex);
+	void RequestTexturesResend(int32 ContextIndex, const FName& TextureName);
+	void BenchmarkDeltaCompression(const TArray<FString>& Args);
+	void BenchmarkPipeline(const TArray<FString>& Args);
+	void StartRecording(const TArray<FString>& Args);
+	void StopRecording(const TArray<FString>& Args);
+	void Replay(const TArray<FString>& Args);
+	void StopReplay(const TArray<FString>& Args);
+
+	// Resolve the path of a recording: relative paths are in the Saved/NetImgui folder, default extension is .nirec
+	// and an empty filename is replaced by one made from the context index and the current date.
+	static FString GetRecordingPath(const FString& Filename, int32 InContextIndex);
+
+	// Number of connections and replays that are pending or open. States of closed connections are not counted.
+	int32 GetNumConnections() const;
+
+	// Address of the game server that a client world connects to.
+	struct FServerAddress
+	{
+		FString Hostname;
+		int32 Port = 0;
+	};
 
 	// shared state
 	FImGuiContextManager* ContextManager = nullptr;
 	uint32 Port;
-	TOptional<int32> ContextIndex;
 
-	// client state
-	TOptional<FString> GameServerHostname;
+	// client state, per context of a client world
+	TMap<int32, FServerAddress> GameServerAddresses;
 
-	// server state
-	FImguiServerState* ServerState = nullptr;
+	// server state, one connection per context index
+	TMap<int32, TUniquePtr<FImguiServerState>> ServerStates;
+	TArray<IConsoleObject*> ConsoleCommands;
 };
@@ -44,6 +44,12 @@ public:
 	/** Implicit conversion to ImTextureID. */
 	operator ImTextureID() const { return GetTextureId(); }
 
+	/** Get the texture coordinates of the upper-left corner of this texture (icons are sub-rects of an atlas page). */
+	const ImVec2& GetUV0() const { return UV0; }
+
+	/** Get the texture coordinates of the lower-right corner of this texture (icons are sub-rects of an atlas page). */
+	const ImVec2& GetUV1() const { return UV1; }
+
 private:
 
 	/**
@@ -53,11 +59,22 @@ private:
 	 */
 	FImGuiTextureHandle(const FName& InName, ImTextureID InTextureId);
 
-	/** Checks if texture manager has entry that matches this name and texture id index. */
+	/**
+	 * Creates a texture handle to a sub-rect of a texture, with known name, texture id and texture coordinates.
+	 * @param InName - Name of the texture
+	 * @param InTextureId - ImGui id of texture
+	 * @param InUV0 - Texture coordinates of the upper-left corner
+	 * @param InUV1 - Texture coordinates of the lower-right corner
+	 */
+	FImGuiTextureHandle(const FName& InName, ImTextureID InTextureId, const ImVec2& InUV0, const ImVec2& InUV1);
+
+	/** Checks if texture manager has entry (or icon) that matches this name and texture id index. */
 	bool HasValidEntry() const;
 
 	FName Name;
 	ImTextureID TextureId;
+	ImVec2 UV0{ 0.f, 0.f };
+	ImVec2 UV1{ 1.f, 1.f };
 
 	// Give module class a private access, so it can create valid handles.
 	friend class FImGuiModule;
@@ -249,6 +249,15 @@ NETIMGUI_API	void				SetBackground(const ImVec4& bgColor, const ImVec4& textureT
 NETIMGUI_API	void				SetCompressionMode(eCompressionMode eMode);
 NETIMGUI_API	eCompressionMode	GetCompressionMode();
 
+//=================================================================================================
+// Adapt the remote frame rate to the connection (0 disables a limit)
+// Frames are skipped instead of queued in the connection, to stay under 'maxBytesPerSecond' of
+// draw data, and the frame rate is lowered while the Server takes more than 'maxLatencyMs'
+// to acknowledge receiving them. Compression is enabled while frames are being throttled,
+// unless disabled with 'SetCompressionMode(kForceDisable)'
+//=================================================================================================
+NETIMGUI_API	void				SetFramePacing(uint32_t maxBytesPerSecond, uint32_t maxLatencyMs);
+
 //=================================================================================================
 // Helper functions
 //=================================================================================================
@@ -99,6 +99,7 @@ void Disconnect(void)
 	
 	Client::ClientInfo& client	= *gpClientInfo;
 	client.mbDisconnectRequest	= true;
+	client.WakeComs();
 	client.KillSocketListen();
 }
 
@@ -168,7 +169,7 @@ bool NewFrame(bool bSupportFrameSkip)
 		
 		// Update input and see if remote netImgui expect a new frame
 		client.mSavedDisplaySize	= ImGui::GetIO().DisplaySize;
-		client.mbValidDrawFrame		= ProcessInputData(client);
+		client.mbValidDrawFrame		= ProcessInputData(client) && !client.IsFramePacingHold();
 		
 		// We are about to start drawing for remote context, check for font data update
 		const ImFontAtlas* pFonts = ImGui::GetIO().Fonts;
@@ -339,6 +340,7 @@ void SendDataTexture(ImTextureID textureId, void* pData, uint16_t width, uint16_
 	}
 	uint32_t idx					= client.mTexturesPendingCreated.fetch_add(1) % static_cast<uint32_t>(ArrayCount(client.mTexturesPending));
 	client.mTexturesPending[idx]	= pCmdTexture;
+	client.WakeComs();
 
 	// If not connected to server yet, update all pending textures
 	if( !IsConnected() )
@@ -417,6 +419,17 @@ eCompressionMode GetCompressionMode()
 	return static_cast<eCompressionMode>(client.mClientCompressionMode);
 }
 
+//=================================================================================================
+void SetFramePacing(uint32_t maxBytesPerSecond, uint32_t maxLatencyMs)
+//=================================================================================================
+{
+	if (!gpClientInfo) return;
+
+	Client::ClientInfo& client		= *gpClientInfo;
+	client.mPacingMaxBytesPerSec	= maxBytesPerSecond;
+	client.mPacingMaxLatencyMs		= maxLatencyMs;
+}
+
 //=================================================================================================
 bool Startup(void)
 //=================================================================================================
@@ -426,7 +439,13 @@ bool Startup(void)
 		gpClientInfo = netImguiNew<Client::ClientInfo>();	
 	}
 	
-	return Network::Startup();
+	if (!Network::Startup())
+		return false;
+
+	if (!gpClientInfo->mpComsWake)
+		gpClientInfo->mpComsWake = Network::WakeCreate();
+
+	return true;
 }
 
 //=================================================================================================
@@ -438,6 +457,8 @@ void Shutdown()
 	Disconnect();
 	while( gpClientInfo->IsActive() )
 		std::this_thread::yield();
+	Network::WakeDestroy(gpClientInfo->mpComsWake);
+	gpClientInfo->mpComsWake = nullptr;
 	Network::Shutdown();
 	
 	netImguiDeleteSafe(gpClientInfo);
@@ -53,6 +53,79 @@ void SavedImguiContext::Restore(ImGuiContext* copyTo)
 #endif
 }
 
+//=================================================================================================
+// FRAME PACING
+// Track DrawFrames until Server acknowledges them, to avoid queuing frames in the connection.
+// Bandwidth budget delays the next DrawFrame by the time the last one takes at allowed rate.
+// Latency over target limits the DrawFrames in flight to 1, so frame rate follows round trip.
+//=================================================================================================
+void FramePacing::Reset()
+{
+	*this = FramePacing();
+}
+
+bool FramePacing::CanSend(TimeSteady timeNow)const
+{
+	return mFramesSentCount < mFramesInFlightAllowed && timeNow >= mNextSendTime;
+}
+
+bool FramePacing::IsThrottled()const
+{
+	return mFramesInFlightAllowed < kFramesInFlightMax || mSendIntervalUs > kThrottledIntervalUs;
+}
+
+void FramePacing::OnFrameSent(uint64_t frameIndex, uint32_t dataSize, uint32_t maxBytesPerSec, TimeSteady timeNow)
+{
+	if( mFramesSentCount < kFramesInFlightMax ){
+		mFramesSent[mFramesSentCount].mFrameIndex	= frameIndex;
+		mFramesSent[mFramesSentCount].mDataSize		= dataSize;
+		mFramesSent[mFramesSentCount].mTime			= timeNow;
+		mFramesSentCount++;
+		mBacklogBytes								+= dataSize;
+	}
+	mSendIntervalUs	= maxBytesPerSec > 0 ? static_cast<uint32_t>(static_cast<uint64_t>(dataSize) * 1000000u / maxBytesPerSec) : 0;
+	mNextSendTime	= timeNow + std::chrono::microseconds(mSendIntervalUs);
+}
+
+void FramePacing::OnFrameAck(uint64_t frameIndexAck, uint32_t maxLatencyMs, TimeSteady timeNow)
+{
+	uint32_t ackCount(0);
+	while( ackCount < mFramesSentCount && mFramesSent[ackCount].mFrameIndex < frameIndexAck ){
+		mBacklogBytes -= mFramesSent[ackCount++].mDataSize;
+	}
+	if( ackCount == 0 ){
+		return;
+	}
+
+	// Latency of the most recent acknowledged DrawFrame
+	const uint32_t latencyUs	= static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(timeNow - mFramesSent[ackCount-1].mTime).count());
+	mLatencyUs					= mLatencyUs == 0 ? latencyUs : (mLatencyUs * 7u + latencyUs) / 8u;
+	for(uint32_t i(ackCount); i < mFramesSentCount; ++i){
+		mFramesSent[i-ackCount] = mFramesSent[i];
+	}
+	mFramesSentCount -= ackCount;
+
+	// Over latency target: wait on each acknowledge before sending. Back under half of it: progressively allow more
+	const uint32_t maxLatencyUs = maxLatencyMs * 1000u;
+	if( maxLatencyUs > 0 && latencyUs > maxLatencyUs ){
+		mFramesInFlightAllowed = 1;
+	}
+	else if( (maxLatencyUs == 0 || latencyUs < maxLatencyUs / 2u) && mFramesInFlightAllowed < kFramesInFlightMax ){
+		mFramesInFlightAllowed++;
+	}
+}
+
+//=================================================================================================
+// Let main thread know if it should skip creating new DrawFrames, and if compression is needed
+//=================================================================================================
+void Communications_FramePacingPublish(ClientInfo& client)
+{
+	const FramePacing& pacing	= client.mFramePacing;
+	client.mPacingNextFrameUs	= std::chrono::duration_cast<std::chrono::microseconds>(pacing.mNextSendTime.time_since_epoch()).count();
+	client.mbPacingHoldFrames	= pacing.mFramesSentCount >= pacing.mFramesInFlightAllowed;
+	client.mbPacingThrottled	= pacing.IsThrottled();
+}
+
 //=================================================================================================
 // GET CLIPBOARD
 // Content received from the Server
@@ -72,6 +145,7 @@ static void SetClipboardTextFn_NetImguiImpl(void* user_data_ctx, const char* tex
 		ClientInfo* pClient				= reinterpret_cast<ClientInfo*>(user_data_ctx);
 		CmdClipboard* pClipboardOut		= CmdClipboard::Create(text);
 		pClient->mPendingClipboardOut.Assign(pClipboardOut);
+		pClient->WakeComs();
 	}
 }
 
@@ -83,6 +157,8 @@ bool Communications_Initialize(ClientInfo& client)
 {
 	CmdVersion cmdVersionSend, cmdVersionRcv;
 	StringCopy(cmdVersionSend.mClientName, client.mName);
+	cmdVersionSend.mEntropyCodecs		= EntropyCodecsSupported();
+	cmdVersionSend.mVertexFormats		= kVertexFormat_Palette;
 	bool bResultSend	= Network::DataSend(client.mpSocketPending, &cmdVersionSend, cmdVersionSend.mHeader.mSize);
 	bool bResultRcv		= Network::DataReceive(client.mpSocketPending, &cmdVersionRcv, sizeof(cmdVersionRcv));
 	bool mbConnected	= bResultRcv && bResultSend && 
@@ -100,6 +176,10 @@ bool Communications_Initialize(ClientInfo& client)
 		client.mBGSettingSent.mTextureId	= client.mBGSetting.mTextureId-1u;	// Force sending the Background settings (by making different than current settings)
 		client.mpSocketComs					= client.mpSocketPending.exchange(nullptr);
 		client.mFrameIndex					= 0;
+		client.mEntropyCodec				= EntropyCodecSelect(cmdVersionSend.mEntropyCodecs & cmdVersionRcv.mEntropyCodecs);
+		client.mVertexFormats				= cmdVersionSend.mVertexFormats & cmdVersionRcv.mVertexFormats;
+		client.mFramePacing.Reset();
+		Communications_FramePacingPublish(client);
 	}
 	return client.mpSocketComs.load() != nullptr;
 }
@@ -116,6 +196,14 @@ void Communications_Incoming_Input(ClientInfo& client, uint8_t*& pCmdData)
 		pCmdData		= nullptr; // Take ownership of the data, prevent Free
 		size_t keyCount(pCmdInput->mKeyCharCount);
 		client.mPendingKeyIn.AddData(pCmdInput->mKeyChars, keyCount);
+		if( pCmdInput->mTexturesResend )
+		{
+			for(auto& texture : client.mTextures)
+			{
+				texture.mbSent = false;
+			}
+			client.mbHasTextureUpdate = true;
+		}
 		client.mPendingInputIn.Assign(pCmdInput);	
 	}
 }
@@ -135,6 +223,20 @@ void Communications_Incoming_Clipboard(ClientInfo& client, uint8_t*& pCmdData)
 	}
 }
 
+//=================================================================================================
+// INCOM: PING
+// End of Server commands, acknowledging the DrawFrames it received
+//=================================================================================================
+void Communications_Incoming_Ping(ClientInfo& client, const uint8_t* pCmdData)
+{
+	if( pCmdData )
+	{
+		auto pCmdPing = reinterpret_cast<const CmdPing*>(pCmdData);
+		client.mFramePacing.OnFrameAck(pCmdPing->mFrameIndexAck, client.mPacingMaxLatencyMs, std::chrono::steady_clock::now());
+		Communications_FramePacingPublish(client);
+	}
+}
+
 //=================================================================================================
 // OUTCOM: TEXTURE
 // Transmit all pending new/updated texture
@@ -182,6 +284,12 @@ bool Communications_Outgoing_Background(ClientInfo& client)
 //=================================================================================================
 bool Communications_Outgoing_Frame(ClientInfo& client)
 {
+	// Frame pacing: leave the pending DrawFrame to be replaced by newer ones, instead of queuing it in the connection
+	const auto timeNow = std::chrono::steady_clock::now();
+	if( !client.mFramePacing.CanSend(timeNow) ){
+		return true;
+	}
+
 	bool bSuccess(true);
 	CmdDrawFrame* pPendingDraw = client.mPendingFrameOut.Release();
 	if( pPendingDraw )
@@ -194,7 +302,7 @@ bool Communications_Outgoing_Frame(ClientInfo& client)
 			// Create a new Compressed DrawFrame Command
 			if( client.mpCmdDrawLast && !client.mServerCompressionSkip ){
 				client.mpCmdDrawLast->ToPointers();
-				CmdDrawFrame* pDrawCompressed	= CompressCmdDrawFrame(client.mpCmdDrawLast, pPendingDraw);
+				CmdDrawFrame* pDrawCompressed	= CompressCmdDrawFrame(client.mpCmdDrawLast, pPendingDraw, client.mEntropyCodec);
 				netImguiDeleteSafe(client.mpCmdDrawLast);
 				client.mpCmdDrawLast			= pPendingDraw;		// Keep original new command for next frame delta compression
 				pPendingDraw					= pDrawCompressed;	// Request compressed copy to be sent to server
@@ -211,6 +319,8 @@ bool Communications_Outgoing_Frame(ClientInfo& client)
 		// Send Command to server
 		pPendingDraw->ToOffsets();
 		bSuccess = Network::DataSend(client.mpSocketComs, pPendingDraw, pPendingDraw->mHeader.mSize);
+		client.mFramePacing.OnFrameSent(pPendingDraw->mFrameIndex, pPendingDraw->mHeader.mSize, client.mPacingMaxBytesPerSec, timeNow);
+		Communications_FramePacingPublish(client);
 
 		//---------------------------------------------------------------------
 		// Free created data once sent (when not used in next frame)
@@ -286,7 +396,7 @@ bool Communications_Incoming(ClientInfo& client)
 		{
 			switch( cmdHeader.mType )
 			{
-			case CmdHeader::eCommands::Ping:		bPingReceived = true; break;
+			case CmdHeader::eCommands::Ping:		bPingReceived = true; Communications_Incoming_Ping(client, pCmdData); break;
 			case CmdHeader::eCommands::Disconnect:	bOk = false; break;
 			case CmdHeader::eCommands::Input:		Communications_Incoming_Input(client, pCmdData); break;
 			case CmdHeader::eCommands::Clipboard:	Communications_Incoming_Clipboard(client, pCmdData); break;
@@ -331,6 +441,20 @@ bool Communications_Outgoing(ClientInfo& client)
 	return bSuccess;
 }
 
+//=================================================================================================
+// WAIT FOR ACTIVITY
+// Block until Server sent us something, or there's new data to send, instead of polling at a
+// fixed rate. Main thread interrupts the wait with the wake object when it queues new data.
+// Returns after kComsKeepAliveMs at most, to keep exchanging pings with Server.
+//=================================================================================================
+void Communications_WaitForActivity(ClientInfo& client)
+{
+	constexpr uint32_t kComsKeepAliveMs	= 100;
+	if( !client.mbDisconnectRequest ){
+		Network::DataReceiveWait(client.mpSocketComs, client.mpComsWake, kComsKeepAliveMs);
+	}
+}
+
 //=================================================================================================
 // COMMUNICATIONS THREAD 
 //=================================================================================================
@@ -344,9 +468,10 @@ void CommunicationsClient(void* pClientVoid)
 	
 	while( bConnected && !pClient->mbDisconnectRequest )
 	{
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-		//std::this_thread::yield();
 		bConnected = Communications_Outgoing(*pClient) && Communications_Incoming(*pClient);
+		if( bConnected ){
+			Communications_WaitForActivity(*pClient);
+		}
 	}
 
 	pClient->KillSocketComs();
@@ -371,9 +496,10 @@ void CommunicationsHost(void* pClientVoid)
 			bool bConnected = Communications_Initialize(*pClient);
 			while (bConnected && !pClient->mbDisconnectRequest)
 			{
-				std::this_thread::sleep_for(std::chrono::milliseconds(1));
-				//std::this_thread::yield();
 				bConnected	= Communications_Outgoing(*pClient) && Communications_Incoming(*pClient);
+				if( bConnected ){
+					Communications_WaitForActivity(*pClient);
+				}
 			}
 			pClient->KillSocketComs();
 		}
@@ -420,6 +546,11 @@ ClientInfo::ClientInfo()
 , mFontTextureID(TextureCastFromUInt(uint64_t(0u)))
 , mTexturesPendingSent(0)
 , mTexturesPendingCreated(0)
+, mPacingMaxBytesPerSec(0)
+, mPacingMaxLatencyMs(0)
+, mPacingNextFrameUs(0)
+, mbPacingHoldFrames(false)
+, mbPacingThrottled(false)
 {
 	memset(mTexturesPending, 0, sizeof(mTexturesPending));
 }
@@ -586,9 +717,10 @@ void ClientInfo::ProcessDrawData(const ImDrawData* pDearImguiData, ImGuiMouseCur
 	if( !mbValidDrawFrame )
 		return;
 
-	CmdDrawFrame* pDrawFrameNew = ConvertToCmdDrawFrame(pDearImguiData, mouseCursor);
-	pDrawFrameNew->mCompressed	= mClientCompressionMode == eCompressionMode::kForceEnable || (mClientCompressionMode == eCompressionMode::kUseServerSetting && mServerCompressionEnabled);
+	CmdDrawFrame* pDrawFrameNew = ConvertToCmdDrawFrame(pDearImguiData, mouseCursor, mVertexFormats);
+	pDrawFrameNew->mCompressed	= mClientCompressionMode == eCompressionMode::kForceEnable || (mClientCompressionMode == eCompressionMode::kUseServerSetting && (mServerCompressionEnabled || mbPacingThrottled));
 	mPendingFrameOut.Assign(pDrawFrameNew);
+	WakeComs();
 }
 
 }}} // namespace NetImgui::Internal::Client
@@ -6,7 +6,7 @@
 //=============================================================================
 // Forward Declares
 //=============================================================================
-namespace NetImgui { namespace Internal { namespace Network { struct SocketInfo; } } }
+namespace NetImgui { namespace Internal { namespace Network { struct SocketInfo; struct WakeInfo; } } }
 
 namespace NetImgui { namespace Internal { namespace Client
 {
@@ -47,6 +47,37 @@ struct SavedImguiContext
 	char					mPadding2[8 - (sizeof(mKeyMap) % 8)]		={};	
 };
 
+//=============================================================================
+// Keep track of DrawFrames sent and acknowledged by Server, to adapt the frame
+// rate to the connection bandwidth and latency (communication thread only)
+//=============================================================================
+struct FramePacing
+{
+	using TimeSteady = std::chrono::steady_clock::time_point;
+	static constexpr uint32_t kFramesInFlightMax	= 4;		// Max DrawFrames sent and not yet acknowledged by Server
+	static constexpr uint32_t kThrottledIntervalUs	= 33333;	// Bandwidth budget spacing DrawFrames more than this, is considered throttling (below 30fps)
+	struct FrameSent
+	{
+		uint64_t	mFrameIndex	= 0;
+		uint32_t	mDataSize	= 0;
+		uint8_t		mPadding[4]	= {};
+		TimeSteady	mTime;
+	};
+	void			Reset();
+	bool			CanSend(TimeSteady timeNow)const;
+	bool			IsThrottled()const;
+	void			OnFrameSent(uint64_t frameIndex, uint32_t dataSize, uint32_t maxBytesPerSec, TimeSteady timeNow);
+	void			OnFrameAck(uint64_t frameIndexAck, uint32_t maxLatencyMs, TimeSteady timeNow);
+	FrameSent		mFramesSent[kFramesInFlightMax];			// DrawFrames sent but not acknowledged yet, in sending order
+	uint32_t		mFramesSentCount		= 0;
+	uint32_t		mFramesInFlightAllowed	= kFramesInFlightMax;// Lowered to 1 while latency is over target, making frame rate follow round trip time
+	uint32_t		mBacklogBytes			= 0;				// Data of DrawFrames sent but not acknowledged yet
+	uint32_t		mLatencyUs				= 0;				// Smoothed time between sending a DrawFrame and receiving its acknowledge
+	uint32_t		mSendIntervalUs			= 0;				// Wait time imposed by bandwidth budget after last DrawFrame sent
+	uint8_t			mPadding[4]				= {};
+	TimeSteady		mNextSendTime;								// Earliest time next DrawFrame can be sent, to respect bandwidth budget
+};
+
 //=============================================================================
 // Keep all Client infos needed for communication with server
 //=============================================================================
@@ -98,6 +129,13 @@ struct ClientInfo
 	Time								mTimeTracking;							// Used to update Dear ImGui time delta on remote context
 	std::atomic_uint32_t				mTexturesPendingSent;
 	std::atomic_uint32_t				mTexturesPendingCreated;
+	Network::WakeInfo*					mpComsWake					= nullptr;	// Signaled when new data is waiting to be sent, communication thread should stop waiting for incoming data
+	FramePacing							mFramePacing;							// DrawFrames sent and acknowledge tracking (communication thread only)
+	std::atomic_uint32_t				mPacingMaxBytesPerSec;					// User setting: DrawFrames bandwidth budget (0 for unlimited)
+	std::atomic_uint32_t				mPacingMaxLatencyMs;					// User setting: DrawFrame acknowledge latency above which frame rate is lowered (0 for unlimited)
+	std::atomic_int64_t					mPacingNextFrameUs;						// Earliest time (steady clock) a new DrawFrame could be sent, skip creating them before
+	std::atomic_bool					mbPacingHoldFrames;						// Too many DrawFrames waiting on acknowledge, skip creating new ones
+	std::atomic_bool					mbPacingThrottled;						// Connection can't keep up with the frame rate, force enable compression
 	
 	bool								mbDisconnectRequest			= false;	// Waiting to Disconnect
 	bool								mbClientThreadActive		= false;
@@ -113,7 +151,8 @@ struct ClientInfo
 	uint8_t								mClientCompressionMode		= eCompressionMode::kUseServerSetting;
 	bool								mServerCompressionEnabled	= false;	// If Server would like compression to be enabled (mClientCompressionMode value can override this value)
 	bool								mServerCompressionSkip		= false;	// Force ignore compression setting for 1 frame
-	char								PADDING[1];
+	uint8_t								mEntropyCodec				= kEntropyCodec_None;	// Entropy coding applied on top of delta compression (negotiated with Server on connection)
+	uint8_t								mVertexFormats				= kVertexFormat_Full;	// Mask of vertex encodings the Server can decode (negotiated with Server on connection)
 	FontCreateFuncPtr					mFontCreationFunction		= nullptr;	// Method to call to generate the remote ImGui font. By default, re-use the local font, but this doesn't handle native DPI scaling on remote server
 	float								mFontCreationScaling		= 1.f;		// Last font scaling used when generating the NetImgui font
 	InputState							mPreviousInputState;					// Keeping track of last keyboard/mouse state
@@ -124,9 +163,11 @@ struct ClientInfo
 	void								ProcessTexturePending();
 	inline bool							IsConnected()const;
 	inline bool							IsConnectPending()const;
+	inline bool							IsFramePacingHold()const;				// If frame pacing wants the next DrawFrame skipped
 	inline bool							IsActive()const;
 	inline void							KillSocketComs();						// Kill communication sockets (should only be called from communication thread)
 	inline void							KillSocketListen();						// Kill connecting listening socket (should only be called from communication thread)
+	inline void							WakeComs();								// Interrupt communication thread wait, new data is waiting to be sent
 
 // Prevent warnings about implicitly created copy
 protected:
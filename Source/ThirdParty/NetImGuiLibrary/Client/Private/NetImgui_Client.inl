@@ -25,6 +25,12 @@ bool ClientInfo::IsConnectPending()const
 	return mpSocketPending.load() != nullptr || mpSocketListen.load() != nullptr;
 }
 
+bool ClientInfo::IsFramePacingHold()const
+{
+	const int64_t timeNowUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	return mbPacingHoldFrames || timeNowUs < mPacingNextFrameUs;
+}
+
 bool ClientInfo::IsActive()const
 {
 	return mbClientThreadActive || mbListenThreadActive;
@@ -54,6 +60,11 @@ void ClientInfo::KillSocketListen()
 	}
 }
 
+void ClientInfo::WakeComs()
+{
+	Network::WakeSignal(mpComsWake);
+}
+
 bool ClientInfo::IsContextOverriden()const
 {
 	return mSavedContextValues.mSavedContext;
@@ -20,7 +20,8 @@ struct CmdHeader
 
 struct alignas(8) CmdPing
 {
-	CmdHeader mHeader = CmdHeader(CmdHeader::eCommands::Ping, sizeof(CmdPing));
+	CmdHeader	mHeader			= CmdHeader(CmdHeader::eCommands::Ping, sizeof(CmdPing));
+	uint64_t	mFrameIndexAck	= 0;	// Index of the last DrawFrame fully received by Server (+1, 0 when none), used by Client frame pacing
 };
 
 struct alignas(8) CmdDisconnect
@@ -46,6 +47,11 @@ struct alignas(8) CmdVersion
 		CustomTexture		= 12,	// Added a 'custom' texture format to let user potentially handle their how format
 		DPIScale			= 13,	// Server now handle monitor DPI
 		Clipboard			= 14,	// Added clipboard support between server/client
+		EntropyCompression	= 15,	// Added optional entropy coding of delta compressed DrawFrame data streams, codecs negotiated in 'CmdVersion'
+		DrawGroupDelta		= 16,	// Compressed DrawFrame signal new/removed DrawGroups explicitly, and DrawGroup delta base is validated by ID
+		VertexPalette		= 17,	// Vertices positions relative to DrawGroup bounding box with exact 1/4 pixel steps, optional color palette negotiated in 'CmdVersion'
+		FramePacing			= 18,	// Server acknowledges received DrawFrames in 'CmdPing', letting Client adapt its frame rate to the connection
+		TexturesResend		= 19,	// Server can request every texture to be sent again in 'CmdInput' (needed when starting a recording)
 		// Insert new version here
 
 		//--------------------------------
@@ -61,7 +67,9 @@ struct alignas(8) CmdVersion
 	uint32_t	mImguiVerID				= IMGUI_VERSION_NUM;
 	uint32_t	mNetImguiVerID			= NETIMGUI_VERSION_NUM;
 	uint8_t		mWCharSize				= static_cast<uint8_t>(sizeof(ImWchar));
-	char		PADDING[3];
+	uint8_t		mEntropyCodecs			= kEntropyCodec_None;	// Mask of 'eEntropyCodec' this side is able and willing to use
+	uint8_t		mVertexFormats			= kVertexFormat_Full;	// Mask of 'eVertexFormat' this side is able to use
+	char		PADDING[1];
 };
 
 struct alignas(8) CmdInput
@@ -193,6 +201,7 @@ struct alignas(8) CmdInput
 	uint16_t						mKeyCharCount					= 0;		// Number of valid input characters
 	bool							mCompressionUse					= false;	// Server would like client to compress the communication data
 	bool							mCompressionSkip				= false;	// Server forcing next client's frame data to be uncompressed
+	bool							mTexturesResend					= false;	// Server requesting every texture to be sent again
 	float							mFontDPIScaling					= 1.f;		// Font scaling request by Server accounting for monitor DPI
 	uint64_t						mMouseDownMask					= 0;
 	uint64_t						mInputDownMask[(ImGuiKey_COUNT+63)/64]={};
@@ -224,7 +233,14 @@ struct alignas(8) CmdDrawFrame
 	uint32_t						mTotalDrawCount		= 0;
 	uint32_t						mUncompressedSize	= 0;
 	uint8_t							mCompressed			= false;
-	uint8_t							PADDING[3]			= {};
+	uint8_t							mEntropyCodec		= kEntropyCodec_None;	// Codec used on the entropy coded data streams of a compressed frame
+	uint8_t							PADDING[2]			= {};
+	uint32_t						mEntropySizeIn		= 0;	// Total size of data streams before entropy coding (only streams that were entropy coded)
+	uint32_t						mEntropySizeOut		= 0;	// Total size of data streams after entropy coding
+	uint32_t						mEntropyEncodeUs	= 0;	// Time spent entropy coding this frame on the client (microseconds)
+	uint32_t						mDrawGroupNewCount	= 0;	// Number of DrawGroups without predecessor in previous frame (compressed frame only)
+	uint32_t						mDrawGroupDelCount	= 0;	// Number of DrawGroups of previous frame without successor in this frame (compressed frame only)
+	uint8_t							PADDING2[4]			= {};
 	OffsetPointer<ImguiDrawGroup>	mpDrawGroups;
 	inline void						ToPointers();
 	inline void						ToOffsets();
@@ -45,6 +45,24 @@ void ImguiDrawGroup::ToOffsets()
 	}
 }
 
+size_t ImguiDrawGroup::GetVertexDataSize()const
+{
+	if( mVertexFormat == kVertexFormat_Palette ){
+		return GetPaletteOffset() + static_cast<size_t>(mColorCount) * sizeof(uint32_t);
+	}
+	return static_cast<size_t>(mVerticeCount) * sizeof(ImguiVert);
+}
+
+size_t ImguiDrawGroup::GetColorIndexOffset()const
+{
+	return static_cast<size_t>(mVerticeCount) * sizeof(ImguiVertPacked);
+}
+
+size_t ImguiDrawGroup::GetPaletteOffset()const
+{
+	return GetColorIndexOffset() + RoundUp<size_t>(mVerticeCount, ComDataSize);
+}
+
 bool CmdInput::IsKeyDown( CmdInput::NetImguiKeys netimguiKey) const
 {
 	uint32_t valIndex	= netimguiKey/64;
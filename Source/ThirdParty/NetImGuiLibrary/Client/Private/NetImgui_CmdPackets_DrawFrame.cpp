@@ -4,6 +4,16 @@
 #include "NetImgui_WarningDisable.h"
 #include "NetImgui_CmdPackets.h"
 
+#if defined(__UNREAL__)
+#include "Math/VectorRegister.h"
+#include "Misc/Compression.h"
+#endif
+
+#include "NetImgui_WarningDisableStd.h"
+#include <algorithm>
+#include <cmath>
+#include "NetImgui_WarningReenable.h"
+
 namespace NetImgui { namespace Internal
 {
 
@@ -63,23 +73,120 @@ inline void ImGui_ExtractIndices(const ImDrawList& cmdList, ImguiDrawGroup& draw
 }
 
 //=================================================================================================
-// 
+// Vertex position relative to the DrawGroup reference coordinate, in 1/kPosSubPixel pixel units
+// (rounded to nearest, so integral and quarter pixel positions are transmitted exactly)
+//=================================================================================================
+inline uint16_t ImGui_EncodeVertexPos(float pos, float referenceCoord)
+{
+	const float value = (pos - referenceCoord) * static_cast<float>(ImguiVert::kPosSubPixel) + 0.5f;
+	return static_cast<uint16_t>(value <= 0.f ? 0.f : (value >= static_cast<float>(0xFFFF) ? static_cast<float>(0xFFFF) : value));
+}
+
+inline uint16_t ImGui_EncodeVertexUV(float uv)
+{
+	return static_cast<uint16_t>((uv - static_cast<float>(ImguiVert::kUvRange_Min)) * 0xFFFF / (ImguiVert::kUvRange_Max - ImguiVert::kUvRange_Min));
+}
+
+//=================================================================================================
+// Find the color palette of a DrawGroup and save each vertex color index in 'pColorIndicesOut'
+// Returns the number of colors found, or 0 when the vertices use more than 256 colors
+//=================================================================================================
+inline uint32_t ImGui_ExtractPalette(const ImDrawList& cmdList, uint32_t* pPaletteOut, uint8_t* pColorIndicesOut)
+{
+	constexpr uint32_t kPaletteMax	= 256;
+	constexpr uint32_t kHashSize	= 2*kPaletteMax;		// Open addressing table of (palette index + 1), 0 when unused
+	uint16_t hashTable[kHashSize]	= {};
+	uint32_t colorCount(0), colorIdx(0);
+	for(int i(0); i<cmdList.VtxBuffer.size(); ++i)
+	{
+		// Consecutive vertices usually share the same color, skip the lookup
+		const uint32_t color = cmdList.VtxBuffer[i].col;
+		if( i == 0 || color != cmdList.VtxBuffer[i-1].col )
+		{
+			uint32_t slot = (color * 2654435761u) >> 23;
+			while( hashTable[slot] != 0 && pPaletteOut[hashTable[slot]-1] != color ){
+				slot = (slot + 1) & (kHashSize - 1);
+			}
+			if( hashTable[slot] == 0 ){
+				if( colorCount == kPaletteMax ){
+					return 0;
+				}
+				pPaletteOut[colorCount++]	= color;
+				hashTable[slot]				= static_cast<uint16_t>(colorCount);
+			}
+			colorIdx = hashTable[slot] - 1u;
+		}
+		pColorIndicesOut[i] = static_cast<uint8_t>(colorIdx);
+	}
+	return colorCount;
+}
+
+//=================================================================================================
+// Save the vertices positions relative to their bounding box, and their colors in a palette
+// when allowed by 'vertexFormats' and it results in less data
 //=================================================================================================
-inline void ImGui_ExtractVertices(const ImDrawList& cmdList, ImguiDrawGroup& drawGroupOut, ComDataType*& pDataOutput)
+inline void ImGui_ExtractVertices(const ImDrawList& cmdList, ImguiDrawGroup& drawGroupOut, ComDataType*& pDataOutput, uint8_t vertexFormats)
 {
 	drawGroupOut.mVerticeCount		= static_cast<uint32_t>(cmdList.VtxBuffer.size());
-	drawGroupOut.mReferenceCoord[0] = drawGroupOut.mVerticeCount > 0 ? cmdList.VtxBuffer[0].pos.x : 0.f;
-	drawGroupOut.mReferenceCoord[1] = drawGroupOut.mVerticeCount > 0 ? cmdList.VtxBuffer[0].pos.y : 0.f;
-	SetAndIncreaseDataPointer(drawGroupOut.mpVertices, drawGroupOut.mVerticeCount*sizeof(ImguiVert), pDataOutput);
-	ImguiVert* pVertices		= drawGroupOut.mpVertices.Get();
-	for(int i(0); i<static_cast<int>(drawGroupOut.mVerticeCount); ++i)
+	drawGroupOut.mVertexFormat		= kVertexFormat_Full;
+	drawGroupOut.mColorCount		= 0;
+	if( drawGroupOut.mVerticeCount == 0 ){
+		drawGroupOut.mpVertices.SetComDataPtr(pDataOutput);
+		return;
+	}
+
+	ImVec2 posMin = cmdList.VtxBuffer[0].pos;
+	for(int i(1); i<cmdList.VtxBuffer.size(); ++i){
+		posMin.x = cmdList.VtxBuffer[i].pos.x < posMin.x ? cmdList.VtxBuffer[i].pos.x : posMin.x;
+		posMin.y = cmdList.VtxBuffer[i].pos.y < posMin.y ? cmdList.VtxBuffer[i].pos.y : posMin.y;
+	}
+	drawGroupOut.mReferenceCoord[0] = std::floor(posMin.x);
+	drawGroupOut.mReferenceCoord[1] = std::floor(posMin.y);
+
+	// Color indices are written in place, before knowing if palette will be used. Palette is kept on the stack until then
+	uint32_t palette[256];
+	if( (vertexFormats & kVertexFormat_Palette) != 0 )
 	{
-		const auto& Vtx			= cmdList.VtxBuffer[i];
-		pVertices[i].mColor		= Vtx.col;
-		pVertices[i].mUV[0]		= static_cast<uint16_t>((Vtx.uv.x	- static_cast<float>(ImguiVert::kUvRange_Min)) * 0xFFFF / (ImguiVert::kUvRange_Max - ImguiVert::kUvRange_Min));
-		pVertices[i].mUV[1]		= static_cast<uint16_t>((Vtx.uv.y	- static_cast<float>(ImguiVert::kUvRange_Min)) * 0xFFFF / (ImguiVert::kUvRange_Max - ImguiVert::kUvRange_Min));
-		pVertices[i].mPos[0]	= static_cast<uint16_t>((Vtx.pos.x	- drawGroupOut.mReferenceCoord[0] - static_cast<float>(ImguiVert::kPosRange_Min)) * 0xFFFF / (ImguiVert::kPosRange_Max - ImguiVert::kPosRange_Min));
-		pVertices[i].mPos[1]	= static_cast<uint16_t>((Vtx.pos.y	- drawGroupOut.mReferenceCoord[1] - static_cast<float>(ImguiVert::kPosRange_Min)) * 0xFFFF / (ImguiVert::kPosRange_Max - ImguiVert::kPosRange_Min));
+		drawGroupOut.mVertexFormat	= kVertexFormat_Palette;
+		uint8_t* pColorIndices		= reinterpret_cast<uint8_t*>(pDataOutput) + drawGroupOut.GetColorIndexOffset();
+		drawGroupOut.mColorCount	= static_cast<uint16_t>(ImGui_ExtractPalette(cmdList, palette, pColorIndices));
+		if( drawGroupOut.mColorCount == 0 || drawGroupOut.GetVertexDataSize() >= drawGroupOut.mVerticeCount * sizeof(ImguiVert) ){
+			drawGroupOut.mVertexFormat	= kVertexFormat_Full;
+			drawGroupOut.mColorCount	= 0;
+		}
+	}
+
+	if( drawGroupOut.mVertexFormat == kVertexFormat_Palette )
+	{
+		// Color indices are already in place (palette starts on a new data element, so they are not cleared here), only their padding needs clearing
+		uint8_t* pColorIndices		= reinterpret_cast<uint8_t*>(pDataOutput) + drawGroupOut.GetColorIndexOffset();
+		SetAndIncreaseDataPointer(drawGroupOut.mpVertices, static_cast<uint32_t>(drawGroupOut.GetVertexDataSize()), pDataOutput);
+		memset(&pColorIndices[drawGroupOut.mVerticeCount], 0, drawGroupOut.GetPaletteOffset() - drawGroupOut.GetColorIndexOffset() - drawGroupOut.mVerticeCount);
+		memcpy(drawGroupOut.mpVertices.Get() + drawGroupOut.GetPaletteOffset(), palette, drawGroupOut.mColorCount * sizeof(uint32_t));
+
+		ImguiVertPacked* pVertices = reinterpret_cast<ImguiVertPacked*>(drawGroupOut.mpVertices.Get());
+		for(int i(0); i<static_cast<int>(drawGroupOut.mVerticeCount); ++i)
+		{
+			const auto& Vtx			= cmdList.VtxBuffer[i];
+			pVertices[i].mUV[0]		= ImGui_EncodeVertexUV(Vtx.uv.x);
+			pVertices[i].mUV[1]		= ImGui_EncodeVertexUV(Vtx.uv.y);
+			pVertices[i].mPos[0]	= ImGui_EncodeVertexPos(Vtx.pos.x, drawGroupOut.mReferenceCoord[0]);
+			pVertices[i].mPos[1]	= ImGui_EncodeVertexPos(Vtx.pos.y, drawGroupOut.mReferenceCoord[1]);
+		}
+	}
+	else
+	{
+		SetAndIncreaseDataPointer(drawGroupOut.mpVertices, static_cast<uint32_t>(drawGroupOut.GetVertexDataSize()), pDataOutput);
+		ImguiVert* pVertices = reinterpret_cast<ImguiVert*>(drawGroupOut.mpVertices.Get());
+		for(int i(0); i<static_cast<int>(drawGroupOut.mVerticeCount); ++i)
+		{
+			const auto& Vtx			= cmdList.VtxBuffer[i];
+			pVertices[i].mColor		= Vtx.col;
+			pVertices[i].mUV[0]		= ImGui_EncodeVertexUV(Vtx.uv.x);
+			pVertices[i].mUV[1]		= ImGui_EncodeVertexUV(Vtx.uv.y);
+			pVertices[i].mPos[0]	= ImGui_EncodeVertexPos(Vtx.pos.x, drawGroupOut.mReferenceCoord[0]);
+			pVertices[i].mPos[1]	= ImGui_EncodeVertexPos(Vtx.pos.y, drawGroupOut.mReferenceCoord[1]);
+		}
 	}
 }
 
@@ -119,13 +226,149 @@ inline void ImGui_ExtractDraws(const ImDrawList& cmdList, ImguiDrawGroup& drawGr
 	pDataOutput += drawGroupOut.mDrawCount * sizeof(ImguiDraw) / ComDataSize;
 }
 
+//=================================================================================================
+// Compare a block of 'kDeltaBlockCount' elements (64 bytes) between 2 data streams
+// Uses the engine vector intrinsics (SSE/NEON) when available, comparing 32bits lanes
+//=================================================================================================
+static constexpr size_t kDeltaBlockCount = 8;
+
+// True when all elements of the block have the same value in both streams
+inline bool DeltaBlockIsSame(const ComDataType* pDataA, const ComDataType* pDataB)
+{
+#if defined(__UNREAL__)
+	const VectorRegister4Int equal01	= VectorIntAnd(	VectorIntCompareEQ(VectorIntLoad(&pDataA[0]), VectorIntLoad(&pDataB[0])),
+														VectorIntCompareEQ(VectorIntLoad(&pDataA[2]), VectorIntLoad(&pDataB[2])));
+	const VectorRegister4Int equal23	= VectorIntAnd(	VectorIntCompareEQ(VectorIntLoad(&pDataA[4]), VectorIntLoad(&pDataB[4])),
+														VectorIntCompareEQ(VectorIntLoad(&pDataA[6]), VectorIntLoad(&pDataB[6])));
+	return VectorMaskBits(VectorCastIntToFloat(VectorIntAnd(equal01, equal23))) == 0xF;
+#else
+	return	((pDataA[0] == pDataB[0]) & (pDataA[1] == pDataB[1]) & (pDataA[2] == pDataB[2]) & (pDataA[3] == pDataB[3]) &
+			 (pDataA[4] == pDataB[4]) & (pDataA[5] == pDataB[5]) & (pDataA[6] == pDataB[6]) & (pDataA[7] == pDataB[7])) != 0;
+#endif
+}
+
+// True when all elements of the block have a different value in both streams
+inline bool DeltaBlockIsChanged(const ComDataType* pDataA, const ComDataType* pDataB)
+{
+#if defined(__UNREAL__)
+	// An element is the same when both of its lanes are, which are adjacent bits of the lanes mask
+	uint32_t laneMask(0);
+	for(uint32_t i(0); i < 4; ++i){
+		const VectorRegister4Int equal	= VectorIntCompareEQ(VectorIntLoad(&pDataA[i*2]), VectorIntLoad(&pDataB[i*2]));
+		laneMask						|= static_cast<uint32_t>(VectorMaskBits(VectorCastIntToFloat(equal))) << (i*4);
+	}
+	return (laneMask & (laneMask >> 1) & 0x5555) == 0;
+#else
+	return	((pDataA[0] != pDataB[0]) & (pDataA[1] != pDataB[1]) & (pDataA[2] != pDataB[2]) & (pDataA[3] != pDataB[3]) &
+			 (pDataA[4] != pDataB[4]) & (pDataA[5] != pDataB[5]) & (pDataA[6] != pDataB[6]) & (pDataA[7] != pDataB[7])) != 0;
+#endif
+}
+
 //=================================================================================================
 // Delta comress data.
 // Take a data stream and output a version with only the difference from other stream is written
+// Output is a list of blocks: [same element count, changed element count] followed by changed values
+// 
+// The first elements of a run are compared one at a time, since data that changes a lot 
+// (scrolling, animations) alternates between very short runs. Past that, whole blocks 
+// are compared at once, and changed data is copied in one go.
 //=================================================================================================
 void CompressData(const ComDataType* pDataPrev, size_t dataSizePrev, const ComDataType* pDataNew, size_t dataSizeNew, ComDataType*& pCommandMemoryInOut)
 {
 	static_assert(sizeof(uint32_t)*2 <= ComDataSize, "Need to adjust compression algorithm pointer calculation");
+	const size_t elemCountPrev	= static_cast<size_t>(DivUp(dataSizePrev, sizeof(uint64_t)));
+	const size_t elemCountNew	= static_cast<size_t>(DivUp(dataSizeNew, sizeof(uint64_t)));
+	const size_t elemCount		= elemCountPrev < elemCountNew ? elemCountPrev : elemCountNew;
+	ComDataType* pDataOutput	= pCommandMemoryInOut;
+	size_t n					= 0;
+	
+	if( pDataPrev )
+	{
+		while(n < elemCount)
+		{
+			uint32_t* pBlockInfo	= reinterpret_cast<uint32_t*>(pDataOutput++); // Add a new block info to output
+
+			// Find number of elements with same value as last frame
+			size_t runStart			= n;
+			size_t scalarEnd		= n + kDeltaBlockCount < elemCount ? n + kDeltaBlockCount : elemCount;
+			while( n < scalarEnd && pDataPrev[n] == pDataNew[n] )
+				++n;
+			if( n == scalarEnd ){
+				while( n + kDeltaBlockCount <= elemCount && DeltaBlockIsSame(&pDataPrev[n], &pDataNew[n]) )
+					n += kDeltaBlockCount;
+				while( n < elemCount && pDataPrev[n] == pDataNew[n] )
+					++n;
+			}
+			pBlockInfo[0]			= static_cast<uint32_t>(n - runStart);
+
+			// Find number of elements with different value as last frame, and save new value
+			runStart				= n;
+			scalarEnd				= n + kDeltaBlockCount < elemCount ? n + kDeltaBlockCount : elemCount;
+			while( n < scalarEnd && pDataPrev[n] != pDataNew[n] )
+				*pDataOutput++		= pDataNew[n++];
+			if( n == scalarEnd ){
+				const size_t copyStart = n;
+				while( n + kDeltaBlockCount <= elemCount && DeltaBlockIsChanged(&pDataPrev[n], &pDataNew[n]) )
+					n += kDeltaBlockCount;
+				while( n < elemCount && pDataPrev[n] != pDataNew[n] )
+					++n;
+				memcpy(pDataOutput, &pDataNew[copyStart], (n - copyStart) * ComDataSize);
+				pDataOutput			+= n - copyStart;
+			}
+			pBlockInfo[1]			= static_cast<uint32_t>(n - runStart);
+		}
+	}
+
+	// New frame has more element than previous frame, add the remaining entries
+	if(elemCount < elemCountNew)
+	{
+		uint32_t* pBlockInfo		= reinterpret_cast<uint32_t*>(pDataOutput++); // Add a new block info to output
+		pBlockInfo[0]				= 0;
+		pBlockInfo[1]				= static_cast<uint32_t>(elemCountNew - n);
+		memcpy(pDataOutput, &pDataNew[n], (elemCountNew - n) * ComDataSize);
+		pDataOutput					+= elemCountNew - n;
+	}
+	pCommandMemoryInOut				= pDataOutput;
+}
+
+//=================================================================================================
+// Unpack a delta data compressed stream
+// Short blocks of changed data are copied directly, avoiding a memcpy call per element or two
+//=================================================================================================
+void DecompressData(const ComDataType* pDataPrev, size_t dataSizePrev, const ComDataType* pDataPack, size_t dataUnpackSize, ComDataType*& pCommandMemoryInOut)
+{
+	const size_t elemCountPrev		= DivUp(dataSizePrev, ComDataSize);
+	const size_t elemCountUnpack	= DivUp(dataUnpackSize, ComDataSize);
+	const size_t elemCountCopy		= elemCountPrev < elemCountUnpack ? elemCountPrev : elemCountUnpack;
+	ComDataType* pDataOutput		= pCommandMemoryInOut;
+	ComDataType* pDataOutputEnd		= &pCommandMemoryInOut[elemCountUnpack];
+	if( pDataPrev ){
+		memcpy(pDataOutput, pDataPrev, elemCountCopy * ComDataSize);
+	}
+	while(pDataOutput < pDataOutputEnd)
+	{
+		const uint32_t* pBlockInfo	= reinterpret_cast<const uint32_t*>(pDataPack++);
+		const uint32_t changedCount	= pBlockInfo[1];
+		pDataOutput					+= pBlockInfo[0];
+		if( changedCount <= kDeltaBlockCount ){
+			for(uint32_t i(0); i < changedCount; ++i)
+				pDataOutput[i]		= pDataPack[i];
+		}
+		else{
+			memcpy(pDataOutput, pDataPack, changedCount * ComDataSize);
+		}
+		pDataOutput					+= changedCount;
+		pDataPack					+= changedCount;
+	}
+	pCommandMemoryInOut				= pDataOutputEnd;
+}
+
+//=================================================================================================
+// Reference delta compression, comparing one element at a time (used to validate and benchmark
+// the block scan implementation, both generate the same data)
+//=================================================================================================
+void CompressDataReference(const ComDataType* pDataPrev, size_t dataSizePrev, const ComDataType* pDataNew, size_t dataSizeNew, ComDataType*& pCommandMemoryInOut)
+{
 	const size_t elemCountPrev	= static_cast<size_t>(DivUp(dataSizePrev, sizeof(uint64_t)));
 	const size_t elemCountNew	= static_cast<size_t>(DivUp(dataSizeNew, sizeof(uint64_t)));
 	const size_t elemCount		= elemCountPrev < elemCountNew ? elemCountPrev : elemCountNew;
@@ -166,9 +409,9 @@ void CompressData(const ComDataType* pDataPrev, size_t dataSizePrev, const ComDa
 }
 
 //=================================================================================================
-// Unpack a delta data compressed stream
+// Reference delta decompression, copying the previous stream before applying the changed blocks
 //=================================================================================================
-void DecompressData(const ComDataType* pDataPrev, size_t dataSizePrev, const ComDataType* pDataPack, size_t dataUnpackSize, ComDataType*& pCommandMemoryInOut)
+void DecompressDataReference(const ComDataType* pDataPrev, size_t dataSizePrev, const ComDataType* pDataPack, size_t dataUnpackSize, ComDataType*& pCommandMemoryInOut)
 {
 	const size_t elemCountPrev		= DivUp(dataSizePrev, ComDataSize);
 	const size_t elemCountUnpack	= DivUp(dataUnpackSize, ComDataSize);
@@ -187,6 +430,192 @@ void DecompressData(const ComDataType* pDataPrev, size_t dataSizePrev, const Com
 	}	
 }
 
+using CompressDataFunc		= void(*)(const ComDataType* pDataPrev, size_t dataSizePrev, const ComDataType* pDataNew, size_t dataSizeNew, ComDataType*& pCommandMemoryInOut);
+using DecompressDataFunc	= void(*)(const ComDataType* pDataPrev, size_t dataSizePrev, const ComDataType* pDataPack, size_t dataUnpackSize, ComDataType*& pCommandMemoryInOut);
+
+//=================================================================================================
+// Entropy coding of delta compressed data streams
+// Delta compression sends changed data as is, which is most of the data of windows that scroll
+// or animate. When both sides support it, streams above a size threshold are also entropy coded.
+// Codecs come from the Unreal Engine compression formats, other builds only support 'None'.
+//=================================================================================================
+static constexpr size_t kEntropyStreamSizeMin = 1024;	// Smaller streams aren't worth the cpu cost
+
+uint8_t EntropyCodecsSupported()
+{
+#if defined(__UNREAL__)
+	uint8_t codecMask	 = FCompression::IsFormatValid(NAME_Zlib) ? kEntropyCodec_Zlib : kEntropyCodec_None;
+	codecMask			|= FCompression::IsFormatValid(NAME_Oodle) ? kEntropyCodec_Oodle : kEntropyCodec_None;
+	return codecMask;
+#else
+	return kEntropyCodec_None;
+#endif
+}
+
+uint8_t EntropyCodecSelect(uint8_t codecMask)
+{
+	return	(codecMask & kEntropyCodec_Oodle)	? kEntropyCodec_Oodle :
+			(codecMask & kEntropyCodec_Zlib)	? kEntropyCodec_Zlib :
+												  kEntropyCodec_None;
+}
+
+#if defined(__UNREAL__)
+inline FName EntropyCodecFormat(uint8_t entropyCodec)
+{
+	return entropyCodec == kEntropyCodec_Oodle ? NAME_Oodle : NAME_Zlib;
+}
+#endif
+
+inline size_t EntropyEncodeBound(uint8_t entropyCodec, size_t dataSize)
+{
+#if defined(__UNREAL__)
+	return static_cast<size_t>(FCompression::CompressMemoryBound(EntropyCodecFormat(entropyCodec), static_cast<int32>(dataSize)));
+#else
+	IM_UNUSED(entropyCodec);
+	return dataSize;
+#endif
+}
+
+inline bool EntropyEncode(uint8_t entropyCodec, const void* pDataIn, size_t dataSizeIn, void* pDataOut, size_t& dataSizeOutInOut)
+{
+#if defined(__UNREAL__)
+	int32 compressedSize	= static_cast<int32>(dataSizeOutInOut);
+	bool bResult			= FCompression::CompressMemory(EntropyCodecFormat(entropyCodec), pDataOut, compressedSize, pDataIn, static_cast<int32>(dataSizeIn));
+	dataSizeOutInOut		= static_cast<size_t>(compressedSize);
+	return bResult;
+#else
+	IM_UNUSED(entropyCodec); IM_UNUSED(pDataIn); IM_UNUSED(dataSizeIn); IM_UNUSED(pDataOut); IM_UNUSED(dataSizeOutInOut);
+	return false;
+#endif
+}
+
+inline bool EntropyDecode(uint8_t entropyCodec, const void* pDataIn, size_t dataSizeIn, void* pDataOut, size_t dataSizeOut)
+{
+#if defined(__UNREAL__)
+	return FCompression::UncompressMemory(EntropyCodecFormat(entropyCodec), pDataOut, static_cast<int32>(dataSizeOut), pDataIn, static_cast<int32>(dataSizeIn));
+#else
+	IM_UNUSED(entropyCodec); IM_UNUSED(pDataIn); IM_UNUSED(dataSizeIn); IM_UNUSED(pDataOut); IM_UNUSED(dataSizeOut);
+	return false;
+#endif
+}
+
+//=================================================================================================
+// Scratch memory used while entropy coding streams of a frame (grows as needed)
+//=================================================================================================
+struct EntropyScratch
+{
+	~EntropyScratch(){ netImguiDeleteSafe(mpData); }
+	ComDataType* Get(size_t dataSize)
+	{
+		if( dataSize > mDataSize ){
+			netImguiDeleteSafe(mpData);
+			mDataSize	= DivUp(dataSize, ComDataSize) * ComDataSize;
+			mpData		= netImguiSizedNew<ComDataType>(mDataSize);
+		}
+		return mpData;
+	}
+	ComDataType*	mpData		= nullptr;
+	size_t			mDataSize	= 0;
+};
+
+//=================================================================================================
+// Entropy code a delta compressed stream in place, when it is large enough and the result smaller
+//=================================================================================================
+void EntropyEncodeStream(uint8_t entropyCodec, ImguiDrawGroup& drawGroup, ImguiDrawGroup::eStream stream, ComDataType* pStreamData, ComDataType*& pCommandMemoryInOut, EntropyScratch& scratch, CmdDrawFrame& drawFrameOut)
+{
+	const size_t deltaSize				= static_cast<size_t>(pCommandMemoryInOut - pStreamData) * ComDataSize;
+	drawGroup.mDeltaSize[stream]		= static_cast<uint32_t>(deltaSize);
+	drawGroup.mEntropySize[stream]		= 0;
+	if( entropyCodec == kEntropyCodec_None || deltaSize < kEntropyStreamSizeMin ){
+		return;
+	}
+
+	const auto timeStart				= std::chrono::high_resolution_clock::now();
+	size_t entropySize					= EntropyEncodeBound(entropyCodec, deltaSize);
+	ComDataType* pEntropyData			= scratch.Get(entropySize);
+	if( EntropyEncode(entropyCodec, pStreamData, deltaSize, pEntropyData, entropySize) && DivUp(entropySize, ComDataSize) < DivUp(deltaSize, ComDataSize) )
+	{
+		const size_t entropyDataCount	= DivUp(entropySize, ComDataSize);
+		memset(reinterpret_cast<uint8_t*>(pEntropyData) + entropySize, 0, entropyDataCount*ComDataSize - entropySize); // Zero the pending bytes
+		memcpy(pStreamData, pEntropyData, entropyDataCount*ComDataSize);
+		pCommandMemoryInOut				= pStreamData + entropyDataCount;
+		drawGroup.mEntropySize[stream]	= static_cast<uint32_t>(entropySize);
+		drawFrameOut.mEntropySizeIn		+= static_cast<uint32_t>(deltaSize);
+		drawFrameOut.mEntropySizeOut	+= static_cast<uint32_t>(entropySize);
+	}
+	const auto timeElapsed				= std::chrono::high_resolution_clock::now() - timeStart;
+	drawFrameOut.mEntropyEncodeUs		+= static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(timeElapsed).count());
+}
+
+//=================================================================================================
+// Return the delta compressed content of a stream, decoding it first when it was entropy coded
+// Returns nullptr when the stream couldn't be decoded
+//=================================================================================================
+const ComDataType* EntropyDecodeStream(uint8_t entropyCodec, const ImguiDrawGroup& drawGroupPack, ImguiDrawGroup::eStream stream, const ComDataType* pStreamData, EntropyScratch& scratch, uint32_t& entropyDecodeUsInOut)
+{
+	if( drawGroupPack.mEntropySize[stream] == 0 ){
+		return pStreamData;
+	}
+
+	const auto timeStart		= std::chrono::high_resolution_clock::now();
+	ComDataType* pDeltaData		= scratch.Get(drawGroupPack.mDeltaSize[stream]);
+	bool bSuccess				= EntropyDecode(entropyCodec, pStreamData, drawGroupPack.mEntropySize[stream], pDeltaData, drawGroupPack.mDeltaSize[stream]);
+	const auto timeElapsed		= std::chrono::high_resolution_clock::now() - timeStart;
+	entropyDecodeUsInOut		+= static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(timeElapsed).count());
+	return bSuccess ? pDeltaData : nullptr;
+}
+
+//=================================================================================================
+// Find the predecessor of each DrawGroup in previous frame, by ID
+// Previous DrawGroups are sorted by ID once per frame, so finding a DrawGroup that moved is a
+// binary search instead of a linear one, even when many windows are opened, closed or reordered.
+// Also keeps track of the previous DrawGroups without successor, to report removed ones
+//=================================================================================================
+class DrawGroupMatcher
+{
+public:
+	explicit DrawGroupMatcher(const CmdDrawFrame& drawFramePrev)
+	: mDrawFramePrev(drawFramePrev)
+	, mMatched(drawFramePrev.mDrawGroupCount, 0)
+	{
+		mSorted.reserve(drawFramePrev.mDrawGroupCount);
+		for(uint32_t i(0); i<drawFramePrev.mDrawGroupCount; ++i){
+			mSorted.push_back({drawFramePrev.mpDrawGroups[i].mGroupID, i});
+		}
+		std::sort(mSorted.begin(), mSorted.end(), [](const Entry& a, const Entry& b){ return a.mGroupID < b.mGroupID || (a.mGroupID == b.mGroupID && a.mGroupIdx < b.mGroupIdx); });
+	}
+
+	// Returns the DrawGroup index in previous frame, or 'kInvalidDrawGroup' when it is a new DrawGroup
+	// Can usually avoid a search by checking 'groupIdxHint' first (drawgroup ordering shouldn't change often)
+	uint32_t Match(uint64_t groupID, uint32_t groupIdxHint)
+	{
+		uint32_t groupIdxPrev(ImguiDrawGroup::kInvalidDrawGroup);
+		if( groupIdxHint < mDrawFramePrev.mDrawGroupCount && mDrawFramePrev.mpDrawGroups[groupIdxHint].mGroupID == groupID ){
+			groupIdxPrev = groupIdxHint;
+		}
+		else {
+			auto entry = std::lower_bound(mSorted.begin(), mSorted.end(), groupID, [](const Entry& e, uint64_t id){ return e.mGroupID < id; });
+			groupIdxPrev = (entry != mSorted.end() && entry->mGroupID == groupID) ? entry->mGroupIdx : ImguiDrawGroup::kInvalidDrawGroup;
+		}
+
+		if( groupIdxPrev != ImguiDrawGroup::kInvalidDrawGroup && !mMatched[groupIdxPrev] ){
+			mMatched[groupIdxPrev] = 1;
+			++mMatchedCount;
+		}
+		return groupIdxPrev;
+	}
+
+	// Number of DrawGroups in previous frame that didn't match any new DrawGroup
+	uint32_t GetUnmatchedCount()const { return mDrawFramePrev.mDrawGroupCount - mMatchedCount; }
+
+protected:
+	struct Entry { uint64_t mGroupID; uint32_t mGroupIdx; };
+	const CmdDrawFrame&		mDrawFramePrev;
+	std::vector<Entry>		mSorted;
+	std::vector<uint8_t>	mMatched;
+	uint32_t				mMatchedCount = 0;
+};
+
 //=================================================================================================
 // Take a regular NetImgui DrawFrame command and create a new compressed command
 // It uses a basic delta compression method that works really well with Imgui data
@@ -197,8 +626,10 @@ void DecompressData(const ComDataType* pDataPrev, size_t dataSizePrev, const Com
 //    - In 'SampleBasic' with 3 windows open (Main Window, ImGui Demo, ImGui Metric) at 30fps
 //		- Compression Off: 1650KB/sec of transfert
 //      - Compression On : 12KB/sec of transfert (130x less data)
+//  - Each DrawGroup is matched by ID with its predecessor, new and removed DrawGroups are counted in the command
+//  - Optionally, each large enough delta compressed stream is then entropy coded with 'entropyCodec'
 //=================================================================================================
-CmdDrawFrame* CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFrameNew)
+static CmdDrawFrame* CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFrameNew, uint8_t entropyCodec, CompressDataFunc compressData)
 {
 	//-----------------------------------------------------------------------------------------
 	// Allocate memory for the new compressed command
@@ -209,6 +640,8 @@ CmdDrawFrame* CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const Cmd
 	CmdDrawFrame* pDrawFramePacked	= netImguiSizedNew<CmdDrawFrame>(neededDataCount*ComDataSize);
 	*pDrawFramePacked				= *pDrawFrameNew;
 	pDrawFramePacked->mCompressed	= true;
+	pDrawFramePacked->mEntropyCodec	= entropyCodec;
+	EntropyScratch entropyScratch;
 
 	ComDataType* pDataOutput		= reinterpret_cast<ComDataType*>(&pDrawFramePacked[1]);
 	SetAndIncreaseDataPointer(pDrawFramePacked->mpDrawGroups, pDrawFramePacked->mDrawGroupCount * sizeof(ImguiDrawGroup), pDataOutput);
@@ -216,20 +649,19 @@ CmdDrawFrame* CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const Cmd
 	//-----------------------------------------------------------------------------------------
 	// Copy draw data (vertices, indices, drawcall info, ...)
 	//-----------------------------------------------------------------------------------------
-	const uint32_t groupCountPrev = pDrawFramePrev->mDrawGroupCount;
+	DrawGroupMatcher drawGroupMatcher(*pDrawFramePrev);
+	pDrawFramePacked->mDrawGroupNewCount = 0;
 	for(uint32_t n = 0; n < pDrawFramePacked->mDrawGroupCount; n++)
 	{
 		// Look for the same drawgroup in previous frame
-		// Can usually avoid a search by checking same index in previous frame (drawgroup ordering shouldn't change often)		
 		const ImguiDrawGroup& drawGroupNew	= pDrawFrameNew->mpDrawGroups[n];
 		ImguiDrawGroup& drawGroup			= pDrawFramePacked->mpDrawGroups[n];
 		drawGroup							= drawGroupNew;
-		drawGroup.mDrawGroupIdxPrev			= (n < groupCountPrev && drawGroup.mGroupID == pDrawFramePrev->mpDrawGroups[n].mGroupID) ? n : ImguiDrawGroup::kInvalidDrawGroup;
-		for(uint32_t j(0); j<groupCountPrev && drawGroup.mDrawGroupIdxPrev == ImguiDrawGroup::kInvalidDrawGroup; ++j){
-			drawGroup.mDrawGroupIdxPrev = (drawGroup.mGroupID == pDrawFramePrev->mpDrawGroups[j].mGroupID) ? j : ImguiDrawGroup::kInvalidDrawGroup;
-		}
+		drawGroup.mDrawGroupIdxPrev			= drawGroupMatcher.Match(drawGroup.mGroupID, n);
+		pDrawFramePacked->mDrawGroupNewCount += drawGroup.mDrawGroupIdxPrev == ImguiDrawGroup::kInvalidDrawGroup ? 1 : 0;
 
-		// Delta compress the 3 data streams
+		// Delta compress the 3 data streams (followed by optional entropy coding)
+		ComDataType* pStreamData(nullptr);
 		const uint64_t *pVerticePrev(nullptr), *pIndicePrev(nullptr), *pDrawsPrev(nullptr);
 		size_t verticeSizePrev(0), indiceSizePrev(0), drawSizePrev(0);
 		if (drawGroup.mDrawGroupIdxPrev < pDrawFramePrev->mDrawGroupCount) {
@@ -237,36 +669,46 @@ CmdDrawFrame* CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const Cmd
 			pVerticePrev						= reinterpret_cast<const uint64_t*>(drawGroupPrev.mpVertices.Get());
 			pIndicePrev							= reinterpret_cast<const uint64_t*>(drawGroupPrev.mpIndices.Get());
 			pDrawsPrev							= reinterpret_cast<const uint64_t*>(drawGroupPrev.mpDraws.Get());
-			verticeSizePrev						= drawGroupPrev.mVerticeCount * sizeof(ImguiVert);
+			verticeSizePrev						= drawGroupPrev.GetVertexDataSize();
 			indiceSizePrev						= drawGroupPrev.mIndiceCount*static_cast<size_t>(drawGroupPrev.mBytePerIndex);
 			drawSizePrev						= drawGroupPrev.mDrawCount*sizeof(ImguiDraw);
 		}
 
+		pStreamData = pDataOutput;
 		drawGroup.mpIndices.SetComDataPtr(pDataOutput);
-		CompressData(	pIndicePrev,							indiceSizePrev,	
+		compressData(	pIndicePrev,							indiceSizePrev,	
 						drawGroupNew.mpIndices.GetComData(),	drawGroupNew.mIndiceCount*static_cast<size_t>(drawGroupNew.mBytePerIndex),
 						pDataOutput);
+		EntropyEncodeStream(entropyCodec, drawGroup, ImguiDrawGroup::kStream_Indices, pStreamData, pDataOutput, entropyScratch, *pDrawFramePacked);
 
+		pStreamData = pDataOutput;
 		drawGroup.mpVertices.SetComDataPtr(pDataOutput);
-		CompressData(	pVerticePrev,							verticeSizePrev,
-						drawGroupNew.mpVertices.GetComData(),	drawGroupNew.mVerticeCount * sizeof(ImguiVert),
+		compressData(	pVerticePrev,							verticeSizePrev,
+						drawGroupNew.mpVertices.GetComData(),	drawGroupNew.GetVertexDataSize(),
 						pDataOutput);
+		EntropyEncodeStream(entropyCodec, drawGroup, ImguiDrawGroup::kStream_Vertices, pStreamData, pDataOutput, entropyScratch, *pDrawFramePacked);
 
+		pStreamData = pDataOutput;
 		drawGroup.mpDraws.SetComDataPtr(pDataOutput);
-		CompressData(	pDrawsPrev,								drawSizePrev,
+		compressData(	pDrawsPrev,								drawSizePrev,
 						drawGroupNew.mpDraws.GetComData(),		drawGroupNew.mDrawCount*sizeof(ImguiDraw),
 						pDataOutput);
+		EntropyEncodeStream(entropyCodec, drawGroup, ImguiDrawGroup::kStream_Draws, pStreamData, pDataOutput, entropyScratch, *pDrawFramePacked);
 	}
 
+	pDrawFramePacked->mDrawGroupDelCount = drawGroupMatcher.GetUnmatchedCount();
+
 	// Adjust data transfert amount to memory that has been actually needed
 	pDrawFramePacked->mHeader.mSize = static_cast<uint32_t>((pDataOutput - reinterpret_cast<ComDataType*>(pDrawFramePacked)))*static_cast<uint32_t>(sizeof(uint64_t));
 	return pDrawFramePacked;
 }
 
 //=================================================================================================
-// 
+// Rebuild the uncompressed DrawFrame command from a compressed one and the previous frame
+// Returns nullptr when entropy coded data couldn't be decoded, or when a DrawGroup delta base
+// doesn't match the previous frame (it would otherwise be rebuilt from another window data)
 //=================================================================================================
-CmdDrawFrame* DecompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFramePacked)
+static CmdDrawFrame* DecompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFramePacked, uint32_t& entropyDecodeUsOut, DecompressDataFunc decompressData)
 {
 	//-----------------------------------------------------------------------------------------
 	// Allocate memory for the new uncompressed compressed command
@@ -274,9 +716,14 @@ CmdDrawFrame* DecompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const C
 	CmdDrawFrame* pDrawFrameNew		= netImguiSizedNew<CmdDrawFrame>(pDrawFramePacked->mUncompressedSize);
 	*pDrawFrameNew					= *pDrawFramePacked;
 	pDrawFrameNew->mCompressed		= false;
+	pDrawFrameNew->mEntropyCodec	= kEntropyCodec_None;
 	ComDataType* pDataOutput		= reinterpret_cast<ComDataType*>(&pDrawFrameNew[1]);
 	SetAndIncreaseDataPointer(pDrawFrameNew->mpDrawGroups, pDrawFrameNew->mDrawGroupCount * sizeof(ImguiDrawGroup), pDataOutput);
 
+	const uint8_t entropyCodec		= pDrawFramePacked->mEntropyCodec;
+	EntropyScratch entropyScratch[ImguiDrawGroup::kStream_Count];
+	entropyDecodeUsOut				= 0;
+
 	for(uint32_t n = 0; n < pDrawFrameNew->mDrawGroupCount; n++)
 	{
 		const ImguiDrawGroup& drawGroupPack	= pDrawFramePacked->mpDrawGroups[n];
@@ -288,40 +735,162 @@ CmdDrawFrame* DecompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const C
 		const ComDataType* pIndicePrev		= nullptr;
 		const ComDataType* pDrawsPrev		= nullptr;
 		size_t verticeSizePrev(0), indiceSizePrev(0), drawSizePrev(0);
-		if (drawGroup.mDrawGroupIdxPrev < pDrawFramePrev->mDrawGroupCount) {
+		if (drawGroup.mDrawGroupIdxPrev != ImguiDrawGroup::kInvalidDrawGroup) {
+			if( drawGroup.mDrawGroupIdxPrev >= pDrawFramePrev->mDrawGroupCount || pDrawFramePrev->mpDrawGroups[drawGroup.mDrawGroupIdxPrev].mGroupID != drawGroup.mGroupID ){
+				netImguiDeleteSafe(pDrawFrameNew);
+				return nullptr;
+			}
 			const ImguiDrawGroup& drawGroupPrev = pDrawFramePrev->mpDrawGroups[drawGroup.mDrawGroupIdxPrev];
 			pVerticePrev					= reinterpret_cast<const ComDataType*>(drawGroupPrev.mpVertices.Get());
 			pIndicePrev						= reinterpret_cast<const ComDataType*>(drawGroupPrev.mpIndices.Get());
 			pDrawsPrev						= reinterpret_cast<const ComDataType*>(drawGroupPrev.mpDraws.Get());
-			verticeSizePrev					= drawGroupPrev.mVerticeCount * sizeof(ImguiVert);
+			verticeSizePrev					= drawGroupPrev.GetVertexDataSize();
 			indiceSizePrev					= drawGroupPrev.mIndiceCount*static_cast<size_t>(drawGroupPrev.mBytePerIndex);
 			drawSizePrev					= drawGroupPrev.mDrawCount*sizeof(ImguiDraw);
 		}
 		
+		// Decode the entropy coded streams first, since the delta blocks can't be trusted on failure
+		const ComDataType* pIndicePack		= EntropyDecodeStream(entropyCodec, drawGroupPack, ImguiDrawGroup::kStream_Indices, drawGroupPack.mpIndices.GetComData(), entropyScratch[ImguiDrawGroup::kStream_Indices], entropyDecodeUsOut);
+		const ComDataType* pVerticePack		= EntropyDecodeStream(entropyCodec, drawGroupPack, ImguiDrawGroup::kStream_Vertices, drawGroupPack.mpVertices.GetComData(), entropyScratch[ImguiDrawGroup::kStream_Vertices], entropyDecodeUsOut);
+		const ComDataType* pDrawsPack		= EntropyDecodeStream(entropyCodec, drawGroupPack, ImguiDrawGroup::kStream_Draws, drawGroupPack.mpDraws.GetComData(), entropyScratch[ImguiDrawGroup::kStream_Draws], entropyDecodeUsOut);
+		if( !pIndicePack || !pVerticePack || !pDrawsPack ){
+			netImguiDeleteSafe(pDrawFrameNew);
+			return nullptr;
+		}
+
 		drawGroup.mpIndices.SetComDataPtr(pDataOutput);
-		DecompressData( pIndicePrev,							indiceSizePrev,
-						drawGroupPack.mpIndices.GetComData(),	drawGroupPack.mIndiceCount*static_cast<size_t>(drawGroupPack.mBytePerIndex),
+		decompressData( pIndicePrev,							indiceSizePrev,
+						pIndicePack,							drawGroupPack.mIndiceCount*static_cast<size_t>(drawGroupPack.mBytePerIndex),
 						pDataOutput);
 
 		drawGroup.mpVertices.SetComDataPtr(pDataOutput);
-		DecompressData(	pVerticePrev,							verticeSizePrev,
-						drawGroupPack.mpVertices.GetComData(),	drawGroupPack.mVerticeCount*sizeof(ImguiVert),
+		decompressData(	pVerticePrev,							verticeSizePrev,
+						pVerticePack,							drawGroupPack.GetVertexDataSize(),
 						pDataOutput);
 			
 		drawGroup.mpDraws.SetComDataPtr(pDataOutput);
-		DecompressData( pDrawsPrev,								drawSizePrev,
-						drawGroupPack.mpDraws.GetComData(),		drawGroupPack.mDrawCount*sizeof(ImguiDraw),
+		decompressData( pDrawsPrev,								drawSizePrev,
+						pDrawsPack,								drawGroupPack.mDrawCount*sizeof(ImguiDraw),
 						pDataOutput);
+
+		for(uint32_t stream(0); stream < ImguiDrawGroup::kStream_Count; ++stream){
+			drawGroup.mDeltaSize[stream]	= 0;
+			drawGroup.mEntropySize[stream]	= 0;
+		}
 	}
 	return pDrawFrameNew;
 }
 
+CmdDrawFrame* CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFrameNew, uint8_t entropyCodec)
+{
+	return CompressCmdDrawFrame(pDrawFramePrev, pDrawFrameNew, entropyCodec, CompressData);
+}
+
+CmdDrawFrame* DecompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFramePacked, uint32_t& entropyDecodeUsOut)
+{
+	return DecompressCmdDrawFrame(pDrawFramePrev, pDrawFramePacked, entropyDecodeUsOut, DecompressData);
+}
+
+//=================================================================================================
+// Move a pointer from one copy of a DrawFrame command to the same location in another copy
+//=================================================================================================
+template <typename TType>
+inline void RebaseDataPointer(OffsetPointer<TType>& dataPointer, const void* pBaseFrom, void* pBaseTo)
+{
+	const size_t offset = static_cast<size_t>(reinterpret_cast<const uint8_t*>(dataPointer.Get()) - reinterpret_cast<const uint8_t*>(pBaseFrom));
+	dataPointer.SetPtr(reinterpret_cast<TType*>(reinterpret_cast<uint8_t*>(pBaseTo) + offset));
+}
+
+//=================================================================================================
+// Copy an uncompressed DrawFrame command (with its data pointers resolved)
+//=================================================================================================
+CmdDrawFrame* CloneCmdDrawFrame(const CmdDrawFrame* pDrawFrame)
+{
+	CmdDrawFrame* pDrawFrameCopy	= netImguiSizedNew<CmdDrawFrame>(pDrawFrame->mUncompressedSize);
+	memcpy(pDrawFrameCopy, pDrawFrame, pDrawFrame->mUncompressedSize);
+	pDrawFrameCopy->mHeader.mSize	= pDrawFrame->mUncompressedSize;
+	RebaseDataPointer(pDrawFrameCopy->mpDrawGroups, pDrawFrame, pDrawFrameCopy);
+	for(uint32_t n = 0; n < pDrawFrameCopy->mDrawGroupCount; n++)
+	{
+		ImguiDrawGroup& drawGroup = pDrawFrameCopy->mpDrawGroups[n];
+		RebaseDataPointer(drawGroup.mpIndices, pDrawFrame, pDrawFrameCopy);
+		RebaseDataPointer(drawGroup.mpVertices, pDrawFrame, pDrawFrameCopy);
+		RebaseDataPointer(drawGroup.mpDraws, pDrawFrame, pDrawFrameCopy);
+	}
+	return pDrawFrameCopy;
+}
+
+//=================================================================================================
+// Delta compress and decompress a pair of consecutive DrawFrames multiple times, with the block
+// scan and the reference implementation, accumulating the time spent in each.
+// Returns false if both implementations don't produce the same data or fail to restore the frame
+//=================================================================================================
+bool BenchmarkDeltaCompression(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFrameNew, uint32_t iterations, DeltaBenchmarkResult& resultInOut)
+{
+	enum eImplementation { kImpl_BlockScan, kImpl_Reference, kImpl_Count };
+	const CompressDataFunc compressFuncs[kImpl_Count]		= { CompressData, CompressDataReference };
+	const DecompressDataFunc decompressFuncs[kImpl_Count]	= { DecompressData, DecompressDataReference };
+	uint64_t* pCompressUs[kImpl_Count]						= { &resultInOut.mCompressUs, &resultInOut.mCompressReferenceUs };
+	uint64_t* pDecompressUs[kImpl_Count]					= { &resultInOut.mDecompressUs, &resultInOut.mDecompressReferenceUs };
+	CmdDrawFrame* pDrawFramePacked[kImpl_Count]				= {};
+	CmdDrawFrame* pDrawFrameUnpacked[kImpl_Count]			= {};
+	uint32_t entropyDecodeUs(0);
+
+	for(uint32_t impl(0); impl < kImpl_Count; ++impl)
+	{
+		const auto timeStart = std::chrono::high_resolution_clock::now();
+		for(uint32_t i(0); i < iterations; ++i){
+			netImguiDeleteSafe(pDrawFramePacked[impl]);
+			pDrawFramePacked[impl] = CompressCmdDrawFrame(pDrawFramePrev, pDrawFrameNew, kEntropyCodec_None, compressFuncs[impl]);
+		}
+		const auto timeCompressed = std::chrono::high_resolution_clock::now();
+		for(uint32_t i(0); i < iterations; ++i){
+			netImguiDeleteSafe(pDrawFrameUnpacked[impl]);
+			pDrawFrameUnpacked[impl] = DecompressCmdDrawFrame(pDrawFramePrev, pDrawFramePacked[impl], entropyDecodeUs, decompressFuncs[impl]);
+		}
+		const auto timeDecompressed = std::chrono::high_resolution_clock::now();
+		*pCompressUs[impl]		+= static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(timeCompressed - timeStart).count());
+		*pDecompressUs[impl]	+= static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(timeDecompressed - timeCompressed).count());
+	}
+
+	// Both implementations must restore the new frame data streams
+	bool bValid = pDrawFramePacked[kImpl_BlockScan] && pDrawFrameUnpacked[kImpl_BlockScan] && pDrawFrameUnpacked[kImpl_Reference];
+	for(uint32_t impl(0); bValid && impl < kImpl_Count; ++impl)
+	{
+		for(uint32_t n = 0; bValid && n < pDrawFrameNew->mDrawGroupCount; n++)
+		{
+			const ImguiDrawGroup& drawGroupNew		= pDrawFrameNew->mpDrawGroups[n];
+			const ImguiDrawGroup& drawGroupUnpacked	= pDrawFrameUnpacked[impl]->mpDrawGroups[n];
+			bValid	=	memcmp(drawGroupNew.mpIndices.Get(), drawGroupUnpacked.mpIndices.Get(), drawGroupNew.mIndiceCount*static_cast<size_t>(drawGroupNew.mBytePerIndex)) == 0 &&
+						memcmp(drawGroupNew.mpVertices.Get(), drawGroupUnpacked.mpVertices.Get(), drawGroupNew.GetVertexDataSize()) == 0 &&
+						memcmp(drawGroupNew.mpDraws.Get(), drawGroupUnpacked.mpDraws.Get(), drawGroupNew.mDrawCount*sizeof(ImguiDraw)) == 0;
+		}
+	}
+
+	// And generate the exact same compressed data
+	if( bValid )
+	{
+		pDrawFramePacked[kImpl_BlockScan]->ToOffsets();
+		pDrawFramePacked[kImpl_Reference]->ToOffsets();
+		bValid = pDrawFramePacked[kImpl_BlockScan]->mHeader.mSize == pDrawFramePacked[kImpl_Reference]->mHeader.mSize &&
+				 memcmp(pDrawFramePacked[kImpl_BlockScan], pDrawFramePacked[kImpl_Reference], pDrawFramePacked[kImpl_BlockScan]->mHeader.mSize) == 0;
+		resultInOut.mDataSize	+= pDrawFrameNew->mUncompressedSize;
+		resultInOut.mPackedSize	+= pDrawFramePacked[kImpl_BlockScan]->mHeader.mSize;
+	}
+
+	for(uint32_t impl(0); impl < kImpl_Count; ++impl){
+		netImguiDeleteSafe(pDrawFramePacked[impl]);
+		netImguiDeleteSafe(pDrawFrameUnpacked[impl]);
+	}
+	return bValid;
+}
+
 //=================================================================================================
 // Take a regular Dear Imgui Draw Data, and convert it to a NetImgui DrawFrame Command
 // It involves saving each window draw group vertex/indices/draw buffers 
 // and packing their data a little bit, to reduce the bandwidth usage
 //=================================================================================================
-CmdDrawFrame* ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouseCursor mouseCursor)
+CmdDrawFrame* ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouseCursor mouseCursor, uint8_t vertexFormats)
 {
 	//-----------------------------------------------------------------------------------------
 	// Find memory needed for entire DrawFrame Command
@@ -334,6 +903,7 @@ CmdDrawFrame* ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouse
 		const ImDrawList* pCmdList	= pDearImguiData->CmdLists[n];
 		bool is16Bit				= pCmdList->VtxBuffer.size() <= 0xFFFF;
 		neededDataCount				+= DivUp(static_cast<size_t>(pCmdList->VtxBuffer.size()) * sizeof(ImguiVert), ComDataSize);
+		neededDataCount				+= (vertexFormats & kVertexFormat_Palette) ? DivUp(static_cast<size_t>(pCmdList->VtxBuffer.size()), ComDataSize) : 0; // Color indices written before knowing if palette is used
 		neededDataCount				+= DivUp(static_cast<size_t>(pCmdList->IdxBuffer.size()) * (is16Bit ? 2 : 4), ComDataSize);
 		neededDataCount				+= DivUp(static_cast<size_t>(pCmdList->CmdBuffer.size()) * sizeof(ImguiDraw), ComDataSize);
 	}
@@ -363,7 +933,7 @@ CmdDrawFrame* ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouse
 		drawGroup						= ImguiDrawGroup();
 		drawGroup.mGroupID				= PointerCast<uint64_t>(pCmdList->_OwnerName); // Use the name string pointer as a unique ID (seems to remain the same between frame)
 		ImGui_ExtractIndices(*pCmdList,	drawGroup, pDataOutput);
-		ImGui_ExtractVertices(*pCmdList,drawGroup, pDataOutput);
+		ImGui_ExtractVertices(*pCmdList,drawGroup, pDataOutput, vertexFormats);
 		ImGui_ExtractDraws(*pCmdList,	drawGroup, pDataOutput);
 		pDrawFrame->mTotalVerticeCount	+= drawGroup.mVerticeCount;
 		pDrawFrame->mTotalIndiceCount	+= drawGroup.mIndiceCount;
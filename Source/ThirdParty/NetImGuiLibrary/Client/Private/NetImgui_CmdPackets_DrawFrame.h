@@ -8,12 +8,27 @@ namespace NetImgui { namespace Internal
 struct ImguiVert
 {
 	//Note: If updating this, increase 'CmdVersion::eVersion'
-	enum Constants{ kUvRange_Min=0, kUvRange_Max=1, kPosRange_Min=-8192, kPosRange_Max=8192};
-	uint16_t	mPos[2];
+	enum Constants{ kUvRange_Min=0, kUvRange_Max=1, kPosSubPixel=4, kPosRange_Max=0xFFFF/kPosSubPixel};
+	uint16_t	mPos[2];		// Position relative to DrawGroup 'mReferenceCoord', in 1/kPosSubPixel pixel units
 	uint16_t	mUV[2];
 	uint32_t	mColor;
 };
 
+// Vertex without color, used by 'kVertexFormat_Palette' DrawGroups
+struct ImguiVertPacked
+{
+	//Note: If updating this, increase 'CmdVersion::eVersion'
+	uint16_t	mPos[2];		// Same encoding as 'ImguiVert'
+	uint16_t	mUV[2];
+};
+
+// Encoding of the DrawGroup vertices (bit mask of supported formats during version exchange)
+enum eVertexFormat : uint8_t
+{
+	kVertexFormat_Full		= 0,		// 'ImguiVert' array
+	kVertexFormat_Palette	= 1 << 0,	// 'ImguiVertPacked' array, followed by 1 byte color index per vertex, followed by the color palette (256 colors max)
+};
+
 struct ImguiDraw
 {
 	uint64_t	mTextureId;
@@ -24,9 +39,18 @@ struct ImguiDraw
 	uint8_t		PADDING[4]={};
 };
 
+// Optional entropy coding applied on top of delta compression (bit mask of supported codecs during version exchange)
+enum eEntropyCodec : uint8_t
+{
+	kEntropyCodec_None	= 0,
+	kEntropyCodec_Zlib	= 1 << 0,
+	kEntropyCodec_Oodle	= 1 << 1,
+};
+
 // Each DearImgui window has its own vertex/index buffers with multiple drawcalls
 struct alignas(8) ImguiDrawGroup
 {
+	enum eStream { kStream_Indices, kStream_Vertices, kStream_Draws, kStream_Count };
 	static constexpr uint32_t	kInvalidDrawGroup	= 0xFFFFFFFF;
 	uint64_t					mGroupID			= 0;				// Unique ID to recognize DrawGroup between 2 frames
 	uint32_t					mVerticeCount		= 0;
@@ -34,17 +58,39 @@ struct alignas(8) ImguiDrawGroup
 	uint32_t					mDrawCount			= 0;
 	uint32_t					mDrawGroupIdxPrev	= kInvalidDrawGroup;// Group index in previous DrawFrame (kInvalidDrawGroup when not using delta compression)
 	uint8_t						mBytePerIndex		= 2;				// 2, 4 bytes
-	uint8_t						PADDING[7]			= {};
-	float						mReferenceCoord[2]	= {};				// Reference position for the encoded vertices offsets (1st vertice top/left position)
+	uint8_t						mVertexFormat		= kVertexFormat_Full;// Encoding of 'mpVertices' data (eVertexFormat)
+	uint16_t					mColorCount			= 0;				// Number of colors in the palette ('kVertexFormat_Palette' only)
+	uint8_t						PADDING[4]			= {};
+	float						mReferenceCoord[2]	= {};				// Reference position for the encoded vertices offsets (vertices bounding box top/left, rounded down)
+	uint32_t					mDeltaSize[kStream_Count]	= {};		// Size of each delta compressed data stream, before entropy coding
+	uint32_t					mEntropySize[kStream_Count]	= {};		// Size of each entropy coded data stream (0 when stream isn't entropy coded)
 	OffsetPointer<uint8_t>		mpIndices;
-	OffsetPointer<ImguiVert>	mpVertices;
+	OffsetPointer<uint8_t>		mpVertices;
 	OffsetPointer<ImguiDraw>	mpDraws;
 	inline void					ToPointers();
 	inline void					ToOffsets();
+	inline size_t				GetVertexDataSize()const;		// Size of 'mpVertices' data, for its 'mVertexFormat'
+	inline size_t				GetColorIndexOffset()const;		// Offset of the color indices in 'mpVertices' data ('kVertexFormat_Palette' only)
+	inline size_t				GetPaletteOffset()const;		// Offset of the color palette in 'mpVertices' data ('kVertexFormat_Palette' only)
+};
+
+// Time spent delta compressing DrawFrames with the block scan and the reference implementation
+struct DeltaBenchmarkResult
+{
+	uint64_t	mDataSize				= 0;	// Uncompressed size of the frames processed
+	uint64_t	mPackedSize				= 0;	// Delta compressed size of the frames processed
+	uint64_t	mCompressUs				= 0;
+	uint64_t	mDecompressUs			= 0;
+	uint64_t	mCompressReferenceUs	= 0;
+	uint64_t	mDecompressReferenceUs	= 0;
 };
 
-struct CmdDrawFrame*	ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouseCursor cursor);
-struct CmdDrawFrame*	CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFrameNew);
-struct CmdDrawFrame*	DecompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFramePacked);
+struct CmdDrawFrame*	ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouseCursor cursor, uint8_t vertexFormats);
+struct CmdDrawFrame*	CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFrameNew, uint8_t entropyCodec);
+struct CmdDrawFrame*	DecompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFramePacked, uint32_t& entropyDecodeUsOut);
+struct CmdDrawFrame*	CloneCmdDrawFrame(const CmdDrawFrame* pDrawFrame);		// Copy of an uncompressed DrawFrame, with its data pointers resolved
+bool					BenchmarkDeltaCompression(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFrameNew, uint32_t iterations, DeltaBenchmarkResult& resultInOut);
+uint8_t					EntropyCodecsSupported();							// Mask of 'eEntropyCodec' available in this build
+uint8_t					EntropyCodecSelect(uint8_t codecMask);				// Preferred codec among a mask of codecs supported by both sides
 
 }} // namespace NetImgui::Internal
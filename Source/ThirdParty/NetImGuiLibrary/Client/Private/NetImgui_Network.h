@@ -4,6 +4,7 @@ namespace NetImgui { namespace Internal { namespace Network
 {
 
 struct SocketInfo;
+struct WakeInfo;
 
 bool		Startup			(void);
 void		Shutdown		(void);
@@ -15,5 +16,10 @@ void		Disconnect		(SocketInfo* pClientSocket);
 
 bool		DataReceive		(SocketInfo* pClientSocket, void* pDataIn, size_t Size);
 bool		DataSend		(SocketInfo* pClientSocket, void* pDataOut, size_t Size);
+bool		DataReceiveWait	(SocketInfo* pClientSocket, WakeInfo* pWake, uint32_t TimeoutMs);	// Wait until data can be received (or connection closed) or wake is signaled, true if before timeout
+
+WakeInfo*	WakeCreate		(void);											// Object used to interrupt DataReceiveWait from another thread
+void		WakeDestroy		(WakeInfo* pWake);
+void		WakeSignal		(WakeInfo* pWake);								// Interrupt pending DataReceiveWait using this object (or the next one, if none pending)
 
 }}} //namespace NetImgui::Internal::Network
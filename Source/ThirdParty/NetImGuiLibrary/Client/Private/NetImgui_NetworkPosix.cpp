@@ -10,6 +10,7 @@
 #include <netdb.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 
 namespace NetImgui { namespace Internal { namespace Network 
 {
@@ -135,6 +136,63 @@ bool DataSend(SocketInfo* pClientSocket, void* pDataOut, size_t Size)
 	return static_cast<int>(Size) == resultSend;
 }
 
+//=================================================================================================
+// Wake object is a pipe polled together with the socket. Signaling it writes a byte that makes
+// the pipe readable, waiting drains it again.
+//=================================================================================================
+struct WakeInfo
+{
+	int mPipe[2];
+};
+
+WakeInfo* WakeCreate()
+{
+	int Pipe[2];
+	if( pipe(Pipe) != 0 )
+		return nullptr;
+
+	SetNonBlocking(Pipe[0], true);
+	SetNonBlocking(Pipe[1], true);
+	WakeInfo* pWake = netImguiNew<WakeInfo>();
+	pWake->mPipe[0]	= Pipe[0];
+	pWake->mPipe[1]	= Pipe[1];
+	return pWake;
+}
+
+void WakeDestroy(WakeInfo* pWake)
+{
+	if( pWake )
+	{
+		close(pWake->mPipe[0]);
+		close(pWake->mPipe[1]);
+		netImguiDelete(pWake);
+	}
+}
+
+void WakeSignal(WakeInfo* pWake)
+{
+	if( pWake )
+	{
+		// A full pipe is already signaled, so failure to write can be ignored
+		char Signal(0);
+		ssize_t Result = write(pWake->mPipe[1], &Signal, 1);
+		(void)Result;
+	}
+}
+
+bool DataReceiveWait(SocketInfo* pClientSocket, WakeInfo* pWake, uint32_t TimeoutMs)
+{
+	pollfd PollInfo[2]	= {	{ pClientSocket->mSocket, POLLIN, 0 },
+							{ pWake ? pWake->mPipe[0] : -1, POLLIN, 0 } };
+	bool bReady			= poll(PollInfo, 2, static_cast<int>(TimeoutMs)) > 0;
+	if( bReady && (PollInfo[1].revents & POLLIN) != 0 )
+	{
+		char Signals[64];
+		while( read(pWake->mPipe[0], Signals, sizeof(Signals)) > 0 ){}
+	}
+	return bReady;
+}
+
 }}} // namespace NetImgui::Internal::Network
 #else
 
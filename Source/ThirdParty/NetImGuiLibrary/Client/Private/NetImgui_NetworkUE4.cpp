@@ -10,6 +10,10 @@
 #include "SocketSubsystem.h"
 #include "Sockets.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include <atomic>
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 2
 #include "IPAddressAsyncResolve.h"
 #endif
@@ -17,6 +21,78 @@
 namespace NetImgui { namespace Internal { namespace Network 
 {
 
+struct WakeInfo
+{
+	WakeInfo() : mpEvent(FPlatformProcess::GetSynchEventFromPool(false)) {}
+	~WakeInfo() { FPlatformProcess::ReturnSynchEventToPool(mpEvent); }
+	FEvent* mpEvent;
+};
+
+//=================================================================================================
+// FSocket can only wait on itself, so it cannot be waited on together with a wake object.
+// Instead, a helper thread waits for the socket to become readable and signals the wake event
+// the communication thread is blocked on. It only watches while a DataReceiveWait is pending.
+//=================================================================================================
+class SocketReadWatcher : public FRunnable
+{
+public:
+	SocketReadWatcher(FSocket* pSocket)
+	: mpSocket(pSocket)
+	, mpArmEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	{
+		mpThread = FRunnableThread::Create(this, TEXT("NetImguiSocketWatcher"), 16 * 1024, TPri_AboveNormal);
+	}
+
+	~SocketReadWatcher()
+	{
+		mbStopRequested = true;
+		mpArmEvent->Trigger();
+		if( mpThread )
+		{
+			mpThread->WaitForCompletion();
+			delete mpThread;
+		}
+		FPlatformProcess::ReturnSynchEventToPool(mpArmEvent);
+	}
+
+	// Start watching the socket (if not already), signaling this wake object once it is readable
+	void Arm(WakeInfo* pWake)
+	{
+		mpNotify = pWake;
+		if( !mbArmed.exchange(true) ){
+			mpArmEvent->Trigger();
+		}
+	}
+
+	virtual uint32 Run() override
+	{
+		while( true )
+		{
+			mpArmEvent->Wait();
+			if( mbStopRequested )
+				break;
+
+			// Closing the connection makes the socket readable, the timeout is only a safety net
+			while( !mbStopRequested && !mpSocket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(1)) ){}
+
+			WakeInfo* pNotify	= mpNotify;
+			mbArmed				= false;
+			if( !mbStopRequested ){
+				pNotify->mpEvent->Trigger();
+			}
+		}
+		return 0;
+	}
+
+private:
+	FSocket*					mpSocket;
+	FEvent*						mpArmEvent;
+	FRunnableThread*			mpThread		= nullptr;
+	std::atomic<WakeInfo*>		mpNotify		= nullptr;
+	std::atomic_bool			mbArmed			= false;
+	std::atomic_bool			mbStopRequested	= false;
+};
+
 struct SocketInfo
 {
 	SocketInfo(FSocket* pSocket) : mpSocket(pSocket) {}
@@ -25,12 +101,19 @@ struct SocketInfo
 	{
 		if(mpSocket )
 		{
+			if( mpWatcher )
+			{
+				// Shutting down the connection releases the watcher from its wait
+				mpSocket->Shutdown(ESocketShutdownMode::ReadWrite);
+				netImguiDeleteSafe(mpWatcher);
+			}
 			mpSocket->Close();
 			ISocketSubsystem::Get()->DestroySocket(mpSocket);
 			mpSocket = nullptr;
 		}
 	}
 	FSocket* mpSocket;
+	SocketReadWatcher* mpWatcher = nullptr;
 };
 
 bool Startup()
@@ -134,6 +217,36 @@ bool DataSend(SocketInfo* pClientSocket, void* pDataOut, size_t Size)
 	return bResult && static_cast<int32>(Size) == sizeSent;
 }
 
+bool DataReceiveWait(SocketInfo* pClientSocket, WakeInfo* pWake, uint32_t TimeoutMs)
+{
+	if( !pWake ){
+		return pClientSocket->mpSocket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(TimeoutMs));
+	}
+
+	if( !pClientSocket->mpWatcher ){
+		pClientSocket->mpWatcher = netImguiNew<SocketReadWatcher>(pClientSocket->mpSocket);
+	}
+	pClientSocket->mpWatcher->Arm(pWake);
+	return pWake->mpEvent->Wait(TimeoutMs);
+}
+
+WakeInfo* WakeCreate()
+{
+	return netImguiNew<WakeInfo>();
+}
+
+void WakeDestroy(WakeInfo* pWake)
+{
+	netImguiDeleteSafe(pWake);
+}
+
+void WakeSignal(WakeInfo* pWake)
+{
+	if( pWake ){
+		pWake->mpEvent->Trigger();
+	}
+}
+
 }}} // namespace NetImgui::Internal::Network
 
 #else
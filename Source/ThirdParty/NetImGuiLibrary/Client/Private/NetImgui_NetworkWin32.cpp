@@ -136,6 +136,77 @@ bool DataSend(SocketInfo* pClientSocket, void* pDataOut, size_t Size)
 	return resultSend != SOCKET_ERROR && static_cast<int>(Size) == resultSend;
 }
 
+//=================================================================================================
+// Wake object is a loopback UDP socket selected together with the communication socket.
+// Signaling it sends a datagram to itself, waiting drains it again.
+//=================================================================================================
+struct WakeInfo
+{
+	SOCKET		mSocket;
+	sockaddr_in	mAddress;
+};
+
+WakeInfo* WakeCreate()
+{
+	SOCKET WakeSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if( WakeSocket == INVALID_SOCKET )
+		return nullptr;
+
+	sockaddr_in Address		= {};
+	int AddressSize			= sizeof(Address);
+	Address.sin_family		= AF_INET;
+	Address.sin_addr.s_addr	= htonl(INADDR_LOOPBACK);
+	Address.sin_port		= 0;
+	if( bind(WakeSocket, reinterpret_cast<sockaddr*>(&Address), sizeof(Address)) == SOCKET_ERROR ||
+		getsockname(WakeSocket, reinterpret_cast<sockaddr*>(&Address), &AddressSize) == SOCKET_ERROR )
+	{
+		closesocket(WakeSocket);
+		return nullptr;
+	}
+
+	SetNonBlocking(WakeSocket, true);
+	WakeInfo* pWake	= netImguiNew<WakeInfo>();
+	pWake->mSocket	= WakeSocket;
+	pWake->mAddress	= Address;
+	return pWake;
+}
+
+void WakeDestroy(WakeInfo* pWake)
+{
+	if( pWake )
+	{
+		closesocket(pWake->mSocket);
+		netImguiDelete(pWake);
+	}
+}
+
+void WakeSignal(WakeInfo* pWake)
+{
+	if( pWake )
+	{
+		char Signal(0);
+		sendto(pWake->mSocket, &Signal, 1, 0, reinterpret_cast<const sockaddr*>(&pWake->mAddress), sizeof(pWake->mAddress));
+	}
+}
+
+bool DataReceiveWait(SocketInfo* pClientSocket, WakeInfo* pWake, uint32_t TimeoutMs)
+{
+	fd_set ReadSet;
+	FD_ZERO(&ReadSet);
+	FD_SET(pClientSocket->mSocket, &ReadSet);
+	if( pWake ){
+		FD_SET(pWake->mSocket, &ReadSet);
+	}
+	timeval Timeout	= { static_cast<long>(TimeoutMs / 1000), static_cast<long>((TimeoutMs % 1000) * 1000) };
+	bool bReady		= select(0, &ReadSet, nullptr, nullptr, &Timeout) > 0;
+	if( bReady && pWake && FD_ISSET(pWake->mSocket, &ReadSet) )
+	{
+		char Signals[64];
+		while( recv(pWake->mSocket, Signals, sizeof(Signals), 0) > 0 ){}
+	}
+	return bReady;
+}
+
 }}} // namespace NetImgui::Internal::Network
 
 #include "NetImgui_WarningReenable.h"
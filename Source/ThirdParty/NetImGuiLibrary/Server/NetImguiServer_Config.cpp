@@ -17,6 +17,7 @@ static constexpr char kConfigField_ServerRefreshActive[]		= "RefreshFPSActive";
 static constexpr char kConfigField_ServerRefreshInactive[]		= "RefreshFPSInactive";
 static constexpr char kConfigField_ServerDPIScaleRatio[]		= "DPIScaleRatio";
 static constexpr char kConfigField_ServerCompressionEnable[]	= "CompressionEnable";
+static constexpr char kConfigField_ServerEntropyCompressionEnable[]	= "EntropyCompressionEnable";
 
 static constexpr char kConfigField_Note[]						= "Note";
 static constexpr char kConfigField_Version[]					= "Version";
@@ -32,6 +33,8 @@ float		Server::sRefreshFPSActive	= 30.f;
 float		Server::sRefreshFPSInactive	= 30.f;
 float		Server::sDPIScaleRatio		= 1.f;
 bool		Server::sCompressionEnable	= true;
+bool		Server::sEntropyCompressionEnable	= false;
+uint32_t	Server::sRecordingKeyframeMs	= 2000;
 
 
 //=================================================================================================
@@ -253,6 +256,7 @@ void Client::SaveConfigFile(eConfigType configFileType, bool writeServerSettings
 		configRoot[kConfigField_ServerRefreshInactive]		= Server::sRefreshFPSInactive;
 		configRoot[kConfigField_ServerDPIScaleRatio]		= Server::sDPIScaleRatio;
 		configRoot[kConfigField_ServerCompressionEnable]	= Server::sCompressionEnable;
+		configRoot[kConfigField_ServerEntropyCompressionEnable]	= Server::sEntropyCompressionEnable;
 	}
 
 	int clientToSaveCount(0);
@@ -319,6 +323,7 @@ void Client::LoadConfigFile(eConfigType configFileType)
 	Server::sRefreshFPSInactive	= GetPropertyValue(configRoot, kConfigField_ServerRefreshInactive,		Server::sRefreshFPSInactive);
 	Server::sDPIScaleRatio		= GetPropertyValue(configRoot, kConfigField_ServerDPIScaleRatio,		Server::sDPIScaleRatio);
 	Server::sCompressionEnable	= GetPropertyValue(configRoot, kConfigField_ServerCompressionEnable,	Server::sCompressionEnable);
+	Server::sEntropyCompressionEnable	= GetPropertyValue(configRoot, kConfigField_ServerEntropyCompressionEnable,	Server::sEntropyCompressionEnable);
 	
 	if( configVersion >= static_cast<uint32_t>(eVersion::Initial) )
 	{	
@@ -81,6 +81,8 @@ struct Server
 	static float	sRefreshFPSInactive;	//!< Refresh rate of inactive Window
 	static float	sDPIScaleRatio;			//!< Ratio of DPI scale applied to Font size (helps with high resolution monitor, default 1.0)
 	static bool		sCompressionEnable;		//!< Ask the clients to compress their data before transmission
+	static bool		sEntropyCompressionEnable;	//!< Let the clients entropy code their compressed data (more cpu usage, for low bandwidth connections)
+	static uint32_t	sRecordingKeyframeMs;	//!< Interval between uncompressed frames requested while recording a client (seek points during playback)
 };
 
 }} // namespace NetImguiServer { namespace Config
@@ -27,6 +27,7 @@ void Communications_Incoming_CmdTexture(RemoteClient::Client* pClient, uint8_t*&
 	{
 		auto pCmdTexture	= reinterpret_cast<NetImgui::Internal::CmdTexture*>(pCmdData);
 		pCmdData			= nullptr; // Take ownership of the data, preventing freeing
+		pClient->mRecorder.AddTexture(pCmdTexture);
 		pCmdTexture->mpTextureData.ToPointer();
 		pClient->ReceiveTexture(pCmdTexture);
 	}
@@ -54,7 +55,11 @@ void Communications_Incoming_CmdDrawFrame(RemoteClient::Client* pClient, uint8_t
 	{
 		auto pCmdDraw		= reinterpret_cast<NetImgui::Internal::CmdDrawFrame*>(pCmdData);
 		pCmdData			= nullptr; // Take ownership of the data, preventing freeing
+		if( pClient->mRecorder.AddDrawFrame(pCmdDraw) ){
+			pClient->mbCompressionSkipOncePending = true; // Request a new keyframe for the recording
+		}
 		pCmdDraw->ToPointers();
+		pClient->mFrameIndexAck	= pCmdDraw->mFrameIndex + 1;
 		pClient->ReceiveDrawFrame(pCmdDraw);
 	}
 }
@@ -161,9 +166,10 @@ bool Communications_Outgoing(NetImgui::Internal::Network::SocketInfo* pClientSoc
 		frameDataSent += cmdDisconnect.mHeader.mSize;
 	}
 
-	// Always finish with a ping
+	// Always finish with a ping (acknowledging received DrawFrames, for client frame pacing)
 	{
 		NetImgui::Internal::CmdPing cmdPing;
+		cmdPing.mFrameIndexAck = pClient->mFrameIndexAck;
 		bSuccess &= NetImgui::Internal::Network::DataSend(pClientSocket, reinterpret_cast<void*>(&cmdPing), cmdPing.mHeader.mSize);
 		frameDataSent += cmdPing.mHeader.mSize;
 	}
@@ -234,6 +240,8 @@ bool Communications_InitializeClient(NetImgui::Internal::Network::SocketInfo* pC
 	NetImgui::Internal::CmdVersion cmdVersionSend;
 	NetImgui::Internal::CmdVersion cmdVersionRcv;
 	NetImgui::Internal::StringCopy(cmdVersionSend.mClientName, "Server");
+	cmdVersionSend.mEntropyCodecs = NetImguiServer::Config::Server::sEntropyCompressionEnable ? NetImgui::Internal::EntropyCodecsSupported() : NetImgui::Internal::kEntropyCodec_None;
+	cmdVersionSend.mVertexFormats = NetImgui::Internal::kVertexFormat_Palette;
 		
 	if(	NetImgui::Internal::Network::DataSend(pClientSocket, reinterpret_cast<void*>(&cmdVersionSend), cmdVersionSend.mHeader.mSize) && 
 		NetImgui::Internal::Network::DataReceive(pClientSocket, reinterpret_cast<void*>(&cmdVersionRcv), cmdVersionRcv.mHeader.mSize) &&
@@ -243,6 +251,7 @@ bool Communications_InitializeClient(NetImgui::Internal::Network::SocketInfo* pC
 		pClient->Initialize();
 		pClient->mInfoImguiVerID	= cmdVersionRcv.mImguiVerID;
 		pClient->mInfoNetImguiVerID = cmdVersionRcv.mNetImguiVerID;
+		pClient->mEntropyCodec		= NetImgui::Internal::EntropyCodecSelect(cmdVersionSend.mEntropyCodecs & cmdVersionRcv.mEntropyCodecs);
 		NetImgui::Internal::StringCopy(pClient->mInfoName,				cmdVersionRcv.mClientName);
 		NetImgui::Internal::StringCopy(pClient->mInfoImguiVerName,		cmdVersionRcv.mImguiVerName);
 		NetImgui::Internal::StringCopy(pClient->mInfoNetImguiVerName,	cmdVersionRcv.mNetImguiVerName);
@@ -0,0 +1,334 @@
+#include "NetImguiServer_Recording.h"
+#include "NetImguiServer_RemoteClient.h"
+#include "NetImguiServer_Config.h"
+
+namespace NetImguiServer { namespace Recording
+{
+
+//=================================================================================================
+// RECORDER
+//=================================================================================================
+Recorder::~Recorder()
+{
+	Stop();
+}
+
+//=================================================================================================
+// Create the recording file. Commands are only recorded once a keyframe is received
+// (caller should request one from the client, along with its textures)
+//=================================================================================================
+bool Recorder::Start(const char* zFilename)
+{
+	std::lock_guard<std::mutex> guard(mLock);
+	if( mFile.is_open() ){
+		return false;
+	}
+
+	mFile.open(zFilename, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+	if( !mFile.is_open() ){
+		return false;
+	}
+
+	FileHeader fileHeader;
+	mFile.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+	mKeyframes.clear();
+	mStartTime		= std::chrono::steady_clock::now();
+	mFileSize		= sizeof(fileHeader);
+	mKeyframeCount	= 0;
+	mbRecording		= mFile.good();
+	return mbRecording;
+}
+
+//=================================================================================================
+// Close the recording file, after appending the keyframe index to it
+//=================================================================================================
+void Recorder::Stop()
+{
+	std::lock_guard<std::mutex> guard(mLock);
+	if( !mFile.is_open() ){
+		return;
+	}
+
+	mbRecording = false;
+	FileFooter fileFooter;
+	fileFooter.mIndexOffset		= mFileSize;
+	fileFooter.mKeyframeCount	= static_cast<uint32_t>(mKeyframes.size());
+	AddChunk(eChunk::Index, mKeyframes.data(), static_cast<uint32_t>(mKeyframes.size() * sizeof(KeyframeEntry)), GetElapsedUs());
+	mFile.write(reinterpret_cast<const char*>(&fileFooter), sizeof(fileFooter));
+	mFile.close();
+	mKeyframes.clear();
+}
+
+//=================================================================================================
+// (COM THREAD) Save a received texture command (before its OffsetPointer is resolved)
+//=================================================================================================
+void Recorder::AddTexture(const NetImgui::Internal::CmdTexture* pCmdTexture)
+{
+	if( !mbRecording ){
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(mLock);
+	if( mbRecording ){
+		AddChunk(eChunk::Texture, pCmdTexture, pCmdTexture->mHeader.mSize, GetElapsedUs());
+	}
+}
+
+//=================================================================================================
+// (COM THREAD) Save a received drawframe command (before its OffsetPointers are resolved)
+// Compressed frames can only be decoded from the previous frame, so we wait for a keyframe
+// before saving any, and regularly request new ones to have seek points during playback.
+//=================================================================================================
+bool Recorder::AddDrawFrame(const NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame)
+{
+	if( !mbRecording ){
+		return false;
+	}
+
+	std::lock_guard<std::mutex> guard(mLock);
+	if( !mbRecording ){
+		return false;
+	}
+
+	const uint64_t timeUs	= GetElapsedUs();
+	const bool isKeyframe	= !pCmdDrawFrame->mCompressed;
+	if( mKeyframes.empty() && !isKeyframe ){
+		return true;
+	}
+
+	if( isKeyframe ){
+		KeyframeEntry keyframe;
+		keyframe.mFileOffset	= mFileSize;
+		keyframe.mTimeUs		= timeUs;
+		keyframe.mFrameIndex	= pCmdDrawFrame->mFrameIndex;
+		mKeyframes.push_back(keyframe);
+		mKeyframeCount			= static_cast<uint32_t>(mKeyframes.size());
+	}
+	AddChunk(eChunk::DrawFrame, pCmdDrawFrame, pCmdDrawFrame->mHeader.mSize, timeUs);
+	return (timeUs - mKeyframes.back().mTimeUs) >= static_cast<uint64_t>(NetImguiServer::Config::Server::sRecordingKeyframeMs) * 1000u;
+}
+
+uint64_t Recorder::GetElapsedUs()const
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - mStartTime).count());
+}
+
+//=================================================================================================
+// Append a chunk to the file (with lock). Recording stops on the first write error
+//=================================================================================================
+void Recorder::AddChunk(eChunk type, const void* pData, uint32_t dataSize, uint64_t timeUs)
+{
+	ChunkHeader chunkHeader;
+	chunkHeader.mType	= type;
+	chunkHeader.mSize	= dataSize;
+	chunkHeader.mTimeUs	= timeUs;
+	mFile.write(reinterpret_cast<const char*>(&chunkHeader), sizeof(chunkHeader));
+	mFile.write(reinterpret_cast<const char*>(pData), dataSize);
+	mFileSize			+= sizeof(chunkHeader) + dataSize;
+	mbRecording			= mbRecording && mFile.good();
+}
+
+//=================================================================================================
+// PLAYER
+//=================================================================================================
+
+//=================================================================================================
+// Open a recording made with the same commands version, and load its keyframe index
+//=================================================================================================
+bool Player::Open(const char* zFilename)
+{
+	Close();
+	mFile.open(zFilename, std::ios_base::binary | std::ios_base::in);
+
+	FileHeader fileHeader;
+	fileHeader.mMagic = 0;
+	mFile.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader));
+	if( !mFile.good() ||
+		fileHeader.mMagic != kFileMagic ||
+		fileHeader.mFileVersion != kFileVersion ||
+		fileHeader.mCmdVersion != static_cast<uint32_t>(NetImgui::Internal::CmdVersion::eVersion::_current) )
+	{
+		Close();
+		return false;
+	}
+
+	// Read the index saved at the end of the file, when the recording was properly closed
+	mFile.seekg(0, std::ios_base::end);
+	const uint64_t fileSize = static_cast<uint64_t>(mFile.tellg());
+	FileFooter fileFooter;
+	ChunkHeader indexHeader;
+	fileFooter.mMagic = 0;
+	if( fileSize >= sizeof(FileHeader) + sizeof(ChunkHeader) + sizeof(FileFooter) )
+	{
+		mFile.seekg(static_cast<std::streamoff>(fileSize - sizeof(FileFooter)));
+		mFile.read(reinterpret_cast<char*>(&fileFooter), sizeof(fileFooter));
+	}
+
+	const uint64_t indexSize = static_cast<uint64_t>(fileFooter.mKeyframeCount) * sizeof(KeyframeEntry);
+	if( mFile.good() && fileFooter.mMagic == kFileMagic && fileFooter.mIndexOffset + sizeof(ChunkHeader) + indexSize + sizeof(FileFooter) == fileSize )
+	{
+		mFile.seekg(static_cast<std::streamoff>(fileFooter.mIndexOffset));
+		mFile.read(reinterpret_cast<char*>(&indexHeader), sizeof(indexHeader));
+		if( mFile.good() && indexHeader.mType == eChunk::Index && indexHeader.mSize == indexSize )
+		{
+			mKeyframes.resize(fileFooter.mKeyframeCount);
+			mFile.read(reinterpret_cast<char*>(mKeyframes.data()), static_cast<std::streamsize>(indexSize));
+			mDataEnd	= fileFooter.mIndexOffset;
+			mDurationUs	= indexHeader.mTimeUs;
+		}
+	}
+
+	if( !mFile.good() || mKeyframes.empty() ){
+		mFile.clear();
+		mKeyframes.clear();
+		mDataEnd = fileSize;
+		BuildIndex();
+	}
+
+	if( mKeyframes.empty() ){
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void Player::Close()
+{
+	mFile.close();
+	mFile.clear();
+	mKeyframes.clear();
+	mbNextChunkValid	= false;
+	mDataEnd			= 0;
+	mDurationUs			= 0;
+}
+
+//=================================================================================================
+// Rebuild the keyframe index by scanning every chunk (when recording was not properly closed).
+// Playback stops at the first incomplete chunk.
+//=================================================================================================
+bool Player::BuildIndex()
+{
+	mFile.seekg(sizeof(FileHeader));
+	uint64_t chunkOffset(sizeof(FileHeader));
+	while( ReadChunkHeader() )
+	{
+		if( mNextChunk.mType == eChunk::DrawFrame && mNextChunk.mSize >= sizeof(NetImgui::Internal::CmdDrawFrame) )
+		{
+			NetImgui::Internal::CmdDrawFrame cmdDrawFrame;
+			mFile.read(reinterpret_cast<char*>(&cmdDrawFrame), sizeof(cmdDrawFrame));
+			if( mFile.good() && !cmdDrawFrame.mCompressed ){
+				KeyframeEntry keyframe;
+				keyframe.mFileOffset	= chunkOffset;
+				keyframe.mTimeUs		= mNextChunk.mTimeUs;
+				keyframe.mFrameIndex	= cmdDrawFrame.mFrameIndex;
+				mKeyframes.push_back(keyframe);
+			}
+		}
+		mDurationUs	= mNextChunk.mTimeUs;
+		chunkOffset	+= sizeof(ChunkHeader) + mNextChunk.mSize;
+		mFile.seekg(static_cast<std::streamoff>(chunkOffset));
+	}
+	mDataEnd	= chunkOffset;
+	mFile.clear();
+	return !mKeyframes.empty();
+}
+
+//=================================================================================================
+// Read the header of the next chunk, making sure its data is entirely available
+//=================================================================================================
+bool Player::ReadChunkHeader()
+{
+	const std::streamoff chunkOffset	= mFile.tellg();
+	mbNextChunkValid					= chunkOffset >= 0 && static_cast<uint64_t>(chunkOffset) + sizeof(ChunkHeader) <= mDataEnd;
+	if( mbNextChunkValid )
+	{
+		mFile.read(reinterpret_cast<char*>(&mNextChunk), sizeof(mNextChunk));
+		mbNextChunkValid = mFile.good() &&
+						   mNextChunk.mType != eChunk::Index &&
+						   static_cast<uint64_t>(chunkOffset) + sizeof(ChunkHeader) + mNextChunk.mSize <= mDataEnd;
+	}
+	return mbNextChunkValid;
+}
+
+//=================================================================================================
+// Read the command of the current chunk and hand it over to the client, like the com thread
+// does with commands received from the network
+//=================================================================================================
+bool Player::ReadChunk(RemoteClient::Client* pClient)
+{
+	const bool isTexture	= mNextChunk.mType == eChunk::Texture && mNextChunk.mSize >= sizeof(NetImgui::Internal::CmdTexture);
+	const bool isDrawFrame	= mNextChunk.mType == eChunk::DrawFrame && mNextChunk.mSize >= sizeof(NetImgui::Internal::CmdDrawFrame);
+	if( !isTexture && !isDrawFrame ){
+		return false;
+	}
+
+	// Only textures are needed when seeking
+	if( !pClient && isDrawFrame ){
+		mFile.seekg(mNextChunk.mSize, std::ios_base::cur);
+		return mFile.good();
+	}
+
+	uint8_t* pCmdData	= NetImgui::Internal::netImguiSizedNew<uint8_t>(mNextChunk.mSize);
+	mFile.read(reinterpret_cast<char*>(pCmdData), mNextChunk.mSize);
+	auto pCmdHeader		= reinterpret_cast<const NetImgui::Internal::CmdHeader*>(pCmdData);
+	bool bValid			= mFile.good() && pCmdHeader->mSize == mNextChunk.mSize;
+	if( bValid && isTexture && pCmdHeader->mType == NetImgui::Internal::CmdHeader::eCommands::Texture )
+	{
+		auto pCmdTexture	= reinterpret_cast<NetImgui::Internal::CmdTexture*>(pCmdData);
+		pCmdData			= nullptr; // Client takes ownership of the data
+		pCmdTexture->mpTextureData.ToPointer();
+		pClient->ReceiveTexture(pCmdTexture);
+	}
+	else if( bValid && isDrawFrame && pCmdHeader->mType == NetImgui::Internal::CmdHeader::eCommands::DrawFrame )
+	{
+		auto pCmdDraw		= reinterpret_cast<NetImgui::Internal::CmdDrawFrame*>(pCmdData);
+		pCmdData			= nullptr; // Client takes ownership of the data
+		pCmdDraw->ToPointers();
+		pClient->ReceiveDrawFrame(pCmdDraw);
+	}
+	else
+	{
+		bValid = false;
+	}
+	NetImgui::Internal::netImguiDeleteSafe(pCmdData);
+	return bValid;
+}
+
+//=================================================================================================
+// Restore the textures in use at a keyframe, and resume playback from it
+//=================================================================================================
+bool Player::Seek(RemoteClient::Client& client, uint32_t keyframe)
+{
+	if( keyframe >= mKeyframes.size() ){
+		return false;
+	}
+
+	mFile.clear();
+	mFile.seekg(sizeof(FileHeader));
+	const uint64_t keyframeOffset(mKeyframes[keyframe].mFileOffset);
+	bool bValid(true);
+	while( bValid && static_cast<uint64_t>(mFile.tellg()) < keyframeOffset )
+	{
+		bValid = ReadChunkHeader() && ReadChunk(mNextChunk.mType == eChunk::Texture ? &client : nullptr);
+	}
+	return bValid && ReadChunkHeader();
+}
+
+//=================================================================================================
+// Send every command recorded up to this time to the client
+//=================================================================================================
+bool Player::Update(RemoteClient::Client& client, uint64_t timeUs)
+{
+	while( mbNextChunkValid && mNextChunk.mTimeUs <= timeUs )
+	{
+		if( ReadChunk(&client) ){
+			ReadChunkHeader();
+		}
+		else{
+			mbNextChunkValid = false;
+		}
+	}
+	return mbNextChunkValid;
+}
+
+}} // namespace NetImguiServer { namespace Recording
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <fstream>
+#include <Private/NetImgui_CmdPackets.h>
+
+namespace NetImguiServer { namespace RemoteClient { struct Client; } } // Forward Declare
+
+namespace NetImguiServer { namespace Recording
+{
+
+//=================================================================================================
+// Recording file layout
+//
+// Commands received from a remote client are appended as they arrive, still compressed and with
+// unresolved OffsetPointers. Uncompressed DrawFrames are keyframes, the only frames that can be
+// decoded without the previous one. Their position is saved in an index when the recording is
+// closed (rebuilt by scanning the chunks when missing, after a crash for example).
+//
+//	FileHeader
+//	ChunkHeader + CmdTexture / CmdDrawFrame		(repeated)
+//	ChunkHeader + KeyframeEntry[]				(index)
+//	FileFooter
+//=================================================================================================
+constexpr uint32_t kFileMagic	= 0x4352494E;	// 'NIRC'
+constexpr uint32_t kFileVersion	= 1;
+
+enum class eChunk : uint32_t
+{
+	Texture,
+	DrawFrame,
+	Index,
+};
+
+struct FileHeader
+{
+	uint32_t	mMagic			= kFileMagic;
+	uint32_t	mFileVersion	= kFileVersion;
+	uint32_t	mCmdVersion		= static_cast<uint32_t>(NetImgui::Internal::CmdVersion::eVersion::_current);	//!< Commands are only readable with the same version
+	uint32_t	PADDING			= 0;
+};
+
+struct ChunkHeader
+{
+	eChunk		mType			= eChunk::Index;
+	uint32_t	mSize			= 0;	//!< Size of the data following this header
+	uint64_t	mTimeUs			= 0;	//!< Time since start of recording
+};
+
+struct KeyframeEntry
+{
+	uint64_t	mFileOffset		= 0;	//!< Position of the keyframe ChunkHeader
+	uint64_t	mTimeUs			= 0;	//!< Time since start of recording
+	uint64_t	mFrameIndex		= 0;	//!< DrawFrame index assigned by remote client
+};
+
+struct FileFooter
+{
+	uint64_t	mIndexOffset	= 0;	//!< Position of the index ChunkHeader
+	uint32_t	mKeyframeCount	= 0;
+	uint32_t	mMagic			= kFileMagic;
+};
+
+//=================================================================================================
+// Append the commands received from a remote client to a recording file
+// Started/Stopped on main thread, commands added on com thread
+//=================================================================================================
+class Recorder
+{
+public:
+						~Recorder();
+	bool				Start(const char* zFilename);
+	void				Stop();
+	inline bool			IsRecording()const			{ return mbRecording; }
+	inline uint64_t		GetFileSize()const			{ return mFileSize; }
+	inline uint32_t		GetKeyframeCount()const		{ return mKeyframeCount; }
+
+	void				AddTexture(const NetImgui::Internal::CmdTexture* pCmdTexture);
+	bool				AddDrawFrame(const NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame);	// Returns true when a new keyframe should be requested from the client
+
+protected:
+	uint64_t			GetElapsedUs()const;
+	void				AddChunk(eChunk type, const void* pData, uint32_t dataSize, uint64_t timeUs);
+
+	std::mutex								mLock;
+	std::ofstream							mFile;
+	std::vector<KeyframeEntry>				mKeyframes;
+	std::chrono::steady_clock::time_point	mStartTime;
+	std::atomic_bool						mbRecording		= false;
+	std::atomic_uint64_t					mFileSize		= 0;
+	std::atomic_uint32_t					mKeyframeCount	= 0;
+};
+
+//=================================================================================================
+// Stream a recording file back to a (disconnected) remote client, that decompress and convert
+// the DrawFrames like it would when receiving them from the network
+// Opened on main thread, then only used by the thread feeding the client
+//=================================================================================================
+class Player
+{
+public:
+	bool				Open(const char* zFilename);
+	void				Close();
+	inline bool			IsOpen()const								{ return mFile.is_open(); }
+	inline uint32_t		GetKeyframeCount()const						{ return static_cast<uint32_t>(mKeyframes.size()); }
+	inline uint64_t		GetKeyframeTimeUs(uint32_t keyframe)const	{ return keyframe < mKeyframes.size() ? mKeyframes[keyframe].mTimeUs : 0; }
+	inline uint64_t		GetDurationUs()const						{ return mDurationUs; }
+	inline uint64_t		GetNextTimeUs()const						{ return mNextChunk.mTimeUs; }
+
+	bool				Seek(RemoteClient::Client& client, uint32_t keyframe);	// Send all textures preceding the keyframe, and resume playback from it
+	bool				Update(RemoteClient::Client& client, uint64_t timeUs);	// Send all commands recorded before this time, returns false once the end is reached
+
+protected:
+	bool				ReadChunkHeader();
+	bool				ReadChunk(RemoteClient::Client* pClient);
+	bool				BuildIndex();
+
+	std::ifstream							mFile;
+	std::vector<KeyframeEntry>				mKeyframes;
+	ChunkHeader								mNextChunk;
+	bool									mbNextChunkValid	= false;
+	uint64_t								mDataEnd			= 0;
+	uint64_t								mDurationUs			= 0;
+};
+
+}} // namespace NetImguiServer { namespace Recording
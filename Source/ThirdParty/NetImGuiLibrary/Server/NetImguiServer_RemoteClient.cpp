@@ -22,11 +22,14 @@ NetImguiImDrawData::NetImguiImDrawData()
 Client::Client()
 : mPendingTextureReadIndex(0)
 , mPendingTextureWriteIndex(0)
+, mFrameCaptureRequested(0)
+, mFrameCaptureCount(0)
 , mbIsVisible(false)
 , mbIsFree(true)
 , mbIsConnected(false)
 , mbDisconnectPending(false)
 , mbCompressionSkipOncePending(false)
+, mbTexturesResendPending(false)
 , mClientConfigID(NetImguiServer::Config::Client::kInvalidRuntimeID)
 {
 }
@@ -38,12 +41,29 @@ Client::~Client()
 
 void Client::ReceiveDrawFrame(NetImgui::Internal::CmdDrawFrame* pFrameData)
 {
+	mStatsCompressionRatio	= 1.f;
+	mStatsEntropyRatio		= 1.f;
+	mStatsEntropyEncodeUs	= 0;
+	mStatsEntropyDecodeUs	= 0;
+	mStatsDrawGroupsNew		= 0;
+	mStatsDrawGroupsDel		= 0;
 	if( pFrameData->mCompressed )
 	{
 		if( mpFrameDrawPrev != nullptr && (mpFrameDrawPrev->mFrameIndex+1) == pFrameData->mFrameIndex ) {
-			NetImgui::Internal::CmdDrawFrame* pUncompressedFrame = NetImgui::Internal::DecompressCmdDrawFrame(mpFrameDrawPrev, pFrameData);
+			mStatsCompressionRatio	= static_cast<float>(pFrameData->mUncompressedSize) / static_cast<float>(pFrameData->mHeader.mSize);
+			mStatsEntropyRatio		= pFrameData->mEntropySizeOut > 0 ? static_cast<float>(pFrameData->mEntropySizeIn) / static_cast<float>(pFrameData->mEntropySizeOut) : 1.f;
+			mStatsEntropyEncodeUs	= pFrameData->mEntropyEncodeUs;
+			mStatsDrawGroupsNew		= pFrameData->mDrawGroupNewCount;
+			mStatsDrawGroupsDel		= pFrameData->mDrawGroupDelCount;
+			NetImgui::Internal::CmdDrawFrame* pUncompressedFrame = NetImgui::Internal::DecompressCmdDrawFrame(mpFrameDrawPrev, pFrameData, mStatsEntropyDecodeUs);
 			netImguiDeleteSafe( pFrameData );
 			pFrameData = pUncompressedFrame;
+
+			// Corrupted entropy coded data or mismatched DrawGroup delta base,
+			// request a new uncompressed frame to be able to resume display
+			if( !pFrameData ){
+				mbCompressionSkipOncePending = true;
+			}
 		}
 		// Missing previous frame data
 		// ignore this drawframe and request a new uncompressed one to be able to resume display
@@ -60,6 +80,11 @@ void Client::ReceiveDrawFrame(NetImgui::Internal::CmdDrawFrame* pFrameData)
 		// Convert DrawFrame command to Dear Imgui DrawData,
 		// and make it available for main thread to use in rendering
 		mpFrameDrawPrev						= pFrameData;
+		mStatsDrawGroups					= pFrameData->mDrawGroupCount;
+		if( mFrameCaptureCount < mFrameCaptureRequested && mFrameCaptureCount < IM_ARRAYSIZE(mpFrameCaptures) ) {
+			mpFrameCaptures[mFrameCaptureCount] = NetImgui::Internal::CloneCmdDrawFrame(pFrameData);
+			++mFrameCaptureCount;
+		}
 		NetImguiImDrawData*	pNewDrawData	= ConvertToImguiDrawData(pFrameData);
 		mPendingImguiDrawDataIn.Assign(pNewDrawData);
 		
@@ -125,6 +150,42 @@ void Client::ProcessPendingTextures()
 	}
 }
 
+// Used when decoding a recording without renderer, to release textures received before they fill the ring buffer
+void Client::DiscardPendingTextures()
+{
+	while( mPendingTextureReadIndex != mPendingTextureWriteIndex )
+	{
+		NetImgui::Internal::netImguiDeleteSafe(mpPendingTextures[(mPendingTextureReadIndex++) % IM_ARRAYSIZE(mpPendingTextures)]);
+	}
+}
+
+// Used on main thread, once all requested frames have been captured (or com thread is done with this client)
+void Client::ReleaseFrameCaptures()
+{
+	mFrameCaptureRequested = 0;
+	for(auto& pFrameCapture : mpFrameCaptures){
+		NetImgui::Internal::netImguiDeleteSafe(pFrameCapture);
+	}
+	mFrameCaptureCount = 0;
+}
+
+// Used on main thread, the recording starts with the next uncompressed frame received,
+// preceded by every texture of the client
+bool Client::StartRecording(const char* zFilename)
+{
+	if( !mRecorder.Start(zFilename) ){
+		return false;
+	}
+	mbTexturesResendPending			= true;
+	mbCompressionSkipOncePending	= true;
+	return true;
+}
+
+void Client::StopRecording()
+{
+	mRecorder.Stop();
+}
+
 void Client::Initialize()
 {
 	mConnectedTime		= std::chrono::steady_clock::now();
@@ -134,10 +195,15 @@ void Client::Initialize()
 	mStatsRcvdBps		= 0;
 	mStatsSentBps		= 0;
 	mStatsFPS			= 0.f;
+	mStatsCompressionRatio	= 1.f;
+	mStatsEntropyRatio		= 1.f;
+	mStatsEntropyEncodeUs	= 0;
+	mStatsEntropyDecodeUs	= 0;
 	mStatsDataRcvd		= 0;
 	mStatsDataSent		= 0;
 	mStatsDataRcvdPrev	= 0;
 	mStatsDataSentPrev	= 0;
+	mFrameIndexAck		= 0;
 	mbIsReleased		= false;
 	mStatsTime			= std::chrono::steady_clock::now();
 	mBGSettings			= NetImgui::Internal::CmdBackground();	// Assign background default value, until we receive first update from client
@@ -162,6 +228,8 @@ void Client::Uninitialize()
 
 	NetImgui::Internal::netImguiDeleteSafe(mpImguiDrawData);
 	NetImgui::Internal::netImguiDeleteSafe(mpFrameDrawPrev);
+	ReleaseFrameCaptures();
+	StopRecording();
 	if (mpBGContext) {
 		ImGui::DestroyContext(mpBGContext);
 		mpBGContext	= nullptr;
@@ -171,6 +239,7 @@ void Client::Uninitialize()
 	mClientIndex					= 0;
 	mClientConfigID					= NetImguiServer::Config::Client::kInvalidRuntimeID;
 	mbCompressionSkipOncePending	= false;
+	mbTexturesResendPending			= false;
 	mbDisconnectPending				= false;
 	mbIsConnected					= false;
 	mbIsFree						= true;
@@ -255,15 +324,25 @@ NetImguiImDrawData*	Client::GetImguiDrawData(void* pEmtpyTextureHAL)
 }
 
 //=================================================================================================
-// Create a new Dear Imgui DrawData ready to be submitted for rendering
+// Decode a network vertex position and uv (same encoding for all vertex formats)
 //=================================================================================================
-NetImguiImDrawData* Client::ConvertToImguiDrawData(const NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame)
+template <typename TVertex>
+inline void ConvertVertexPosUV(const TVertex& vertexSrc, const NetImgui::Internal::ImguiDrawGroup& drawGroup, ImDrawVert& vertexDst)
 {
-	constexpr float kPosRangeMin	= static_cast<float>(NetImgui::Internal::ImguiVert::kPosRange_Min);
-	constexpr float kPosRangeMax	= static_cast<float>(NetImgui::Internal::ImguiVert::kPosRange_Max);
+	constexpr float kPosScale		= 1.f / static_cast<float>(NetImgui::Internal::ImguiVert::kPosSubPixel);
 	constexpr float kUVRangeMin		= static_cast<float>(NetImgui::Internal::ImguiVert::kUvRange_Min);
 	constexpr float kUVRangeMax		= static_cast<float>(NetImgui::Internal::ImguiVert::kUvRange_Max);
+	vertexDst.pos.x					= static_cast<float>(vertexSrc.mPos[0]) * kPosScale + drawGroup.mReferenceCoord[0];
+	vertexDst.pos.y					= static_cast<float>(vertexSrc.mPos[1]) * kPosScale + drawGroup.mReferenceCoord[1];
+	vertexDst.uv.x					= (static_cast<float>(vertexSrc.mUV[0]) * (kUVRangeMax - kUVRangeMin)) / static_cast<float>(0xFFFF) + kUVRangeMin;
+	vertexDst.uv.y					= (static_cast<float>(vertexSrc.mUV[1]) * (kUVRangeMax - kUVRangeMin)) / static_cast<float>(0xFFFF) + kUVRangeMin;
+}
 
+//=================================================================================================
+// Create a new Dear Imgui DrawData ready to be submitted for rendering
+//=================================================================================================
+NetImguiImDrawData* Client::ConvertToImguiDrawData(const NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame)
+{
 	if (!pCmdDrawFrame){
 		return nullptr;
 	}
@@ -312,14 +391,25 @@ NetImguiImDrawData* Client::ConvertToImguiDrawData(const NetImgui::Internal::Cmd
 		}
 
 		// Convert the Vertices from network command to Dear Imgui Format
-		const NetImgui::Internal::ImguiVert* pVertexSrc = drawGroup.mpVertices.Get();
-		for (uint32_t vtxIdx(0); vtxIdx < drawGroup.mVerticeCount; ++vtxIdx)
+		if( drawGroup.mVertexFormat == NetImgui::Internal::kVertexFormat_Palette )
+		{
+			const NetImgui::Internal::ImguiVertPacked* pVertexSrc	= reinterpret_cast<const NetImgui::Internal::ImguiVertPacked*>(drawGroup.mpVertices.Get());
+			const uint8_t* pColorIndices							= drawGroup.mpVertices.Get() + drawGroup.GetColorIndexOffset();
+			const uint32_t* pPalette								= reinterpret_cast<const uint32_t*>(drawGroup.mpVertices.Get() + drawGroup.GetPaletteOffset());
+			for (uint32_t vtxIdx(0); vtxIdx < drawGroup.mVerticeCount; ++vtxIdx)
+			{
+				ConvertVertexPosUV(pVertexSrc[vtxIdx], drawGroup, pVertexDst[vtxIdx]);
+				pVertexDst[vtxIdx].col				= pPalette[pColorIndices[vtxIdx]];
+			}
+		}
+		else
 		{
-			pVertexDst[vtxIdx].pos.x				= (static_cast<float>(pVertexSrc[vtxIdx].mPos[0]) * (kPosRangeMax - kPosRangeMin)) / static_cast<float>(0xFFFF) + kPosRangeMin + drawGroup.mReferenceCoord[0];
-			pVertexDst[vtxIdx].pos.y				= (static_cast<float>(pVertexSrc[vtxIdx].mPos[1]) * (kPosRangeMax - kPosRangeMin)) / static_cast<float>(0xFFFF) + kPosRangeMin + drawGroup.mReferenceCoord[1];
-			pVertexDst[vtxIdx].uv.x					= (static_cast<float>(pVertexSrc[vtxIdx].mUV[0]) * (kUVRangeMax - kUVRangeMin)) / static_cast<float>(0xFFFF) + kUVRangeMin;
-			pVertexDst[vtxIdx].uv.y					= (static_cast<float>(pVertexSrc[vtxIdx].mUV[1]) * (kUVRangeMax - kUVRangeMin)) / static_cast<float>(0xFFFF) + kUVRangeMin;
-			pVertexDst[vtxIdx].col					= pVertexSrc[vtxIdx].mColor;
+			const NetImgui::Internal::ImguiVert* pVertexSrc = reinterpret_cast<const NetImgui::Internal::ImguiVert*>(drawGroup.mpVertices.Get());
+			for (uint32_t vtxIdx(0); vtxIdx < drawGroup.mVerticeCount; ++vtxIdx)
+			{
+				ConvertVertexPosUV(pVertexSrc[vtxIdx], drawGroup, pVertexDst[vtxIdx]);
+				pVertexDst[vtxIdx].col				= pVertexSrc[vtxIdx].mColor;
+			}
 		}
 
 		// Convert the Draws from network command to Dear Imgui Format
@@ -435,6 +525,7 @@ void Client::CaptureImguiInput()
 	// pNewInput->mCompressionSkip		= mbCompressionSkipOncePending;
 	pNewInput->mCompressionSkip		= mbCompressionSkipOncePending || pNewInput->mCompressionSkip;
 	// BV END
+	pNewInput->mTexturesResend		= mbTexturesResendPending.exchange(false) || pNewInput->mTexturesResend;
 	pNewInput->mFontDPIScaling		= config.mDPIScaleEnabled ? NetImguiServer::UI::GetFontDPIScale() : 1.f;
 	mbCompressionSkipOncePending	= false;
 
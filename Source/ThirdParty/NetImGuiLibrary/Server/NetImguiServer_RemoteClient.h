@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <Private/NetImgui_CmdPackets.h>
 #include "NetImguiServer_App.h"
+#include "NetImguiServer_Recording.h"
 
 namespace NetImguiServer { namespace RemoteClient
 {
@@ -54,6 +55,10 @@ struct Client
 	NetImgui::Internal::CmdInput*			TakePendingInput();
 	NetImgui::Internal::CmdClipboard*		TakePendingClipboard();
 	void									ProcessPendingTextures();
+	void									DiscardPendingTextures();
+	void									ReleaseFrameCaptures();
+	bool									StartRecording(const char* zFilename);
+	void									StopRecording();
 
 	void*									mpHAL_AreaRT			= nullptr;
 	void*									mpHAL_AreaTexture		= nullptr;
@@ -82,6 +87,10 @@ struct Client
 	NetImgui::Internal::CmdTexture*			mpPendingTextures[64]	= {};		//!< Textures commands waiting to be processed in main update loop
 	std::atomic_uint64_t					mPendingTextureReadIndex;
 	std::atomic_uint64_t					mPendingTextureWriteIndex;
+	NetImgui::Internal::CmdDrawFrame*		mpFrameCaptures[32]		= {};		//!< Copies of received DrawFrames, to benchmark delta compression on real data
+	std::atomic_uint32_t					mFrameCaptureRequested;				//!< Number of DrawFrames to capture (set by main thread, when no capture is pending)
+	std::atomic_uint32_t					mFrameCaptureCount;					//!< Number of DrawFrames captured (set by com thread, until it reaches requested count)
+	Recording::Recorder						mRecorder;							//!< Saves received commands to a file, when started
 	bool									mbIsVisible				= false;	//!< If currently shown
 	bool									mbIsActive				= false;	//!< Is the current active window (will receive input, only one is true at a time)
 	bool									mbIsReleased			= false;	//!< If released in com thread and main thread should delete resources
@@ -89,11 +98,13 @@ struct Client
 	std::atomic_bool						mbIsConnected;						//!< If connected to a remote client
 	std::atomic_bool						mbDisconnectPending;				//!< Server requested a disconnect on this item
 	std::atomic_bool						mbCompressionSkipOncePending;		//!< When we detect invalid previous DrawFrame command, cancel compression for 1 frame, to get good data
+	std::atomic_bool						mbTexturesResendPending;			//!< Request every texture to be sent again by the client (needed by recordings)
 	std::chrono::steady_clock::time_point	mConnectedTime;						//!< When the connection was established with this remote client
 	std::chrono::steady_clock::time_point	mLastUpdateTime;					//!< When the client last send a content refresh request
 	std::chrono::steady_clock::time_point	mLastDrawFrame;						//!< When we last receive a new drawframe commant	
 	uint32_t								mClientConfigID;					//!< ID of ClientConfig that connected (if connection came from our list of ClientConfigs)	
 	uint32_t								mClientIndex			= 0;		//!< Entry idx into table of connected clients
+	uint64_t								mFrameIndexAck			= 0;		//!< Last DrawFrame index received (+1), acknowledged to the client in each Ping (com thread only)
 	uint64_t								mStatsDataRcvd;						//!< Current amount of Bytes received since connected
 	uint64_t								mStatsDataSent;						//!< Current amount of Bytes sent to client since connected
 	uint64_t								mStatsDataRcvdPrev;					//!< Last amount of Bytes received since connected
@@ -102,7 +113,15 @@ struct Client
 	uint32_t								mStatsRcvdBps;						//!< Average Bytes received per second
 	uint32_t								mStatsSentBps;						//!< Average Bytes sent per second
 	float									mStatsFPS;							//!< Average refresh rate of content
+	float									mStatsCompressionRatio;				//!< Last DrawFrame uncompressed size / received size
+	float									mStatsEntropyRatio;					//!< Last DrawFrame entropy coded streams size before / after entropy coding
+	uint32_t								mStatsEntropyEncodeUs;				//!< Last DrawFrame time spent entropy coding on the remote client (microseconds)
+	uint32_t								mStatsEntropyDecodeUs;				//!< Last DrawFrame time spent entropy decoding (microseconds)
+	uint32_t								mStatsDrawGroups		= 0;		//!< Last DrawFrame number of DrawGroups
+	uint32_t								mStatsDrawGroupsNew		= 0;		//!< Last DrawFrame number of DrawGroups sent without delta base (new since previous frame)
+	uint32_t								mStatsDrawGroupsDel		= 0;		//!< Last DrawFrame number of DrawGroups removed since previous frame
 	uint32_t								mStatsIndex;
+	uint8_t									mEntropyCodec			= 0;		//!< Entropy coding negotiated with the remote client (eEntropyCodec)
 	float									mMousePos[2]				= {0,0};
 	float									mMouseWheelPos[2]			= {0,0};
 	ImGuiMouseCursor						mMouseCursor				= ImGuiMouseCursor_None;	// Last mosue cursor remote client requested
@@ -104,6 +104,8 @@ void ClientInfoTooltip(const RemoteClient::Client& Client)
 		ImGui::TextUnformatted("Fps");		ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %04.1f", Client.mStatsFPS );
 		ImGui::TextUnformatted("Data");		ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": (Rx) %7i KB/s \t(Tx) %7i KB/s", Client.mStatsRcvdBps/1024, Client.mStatsSentBps/1024);
 		ImGui::NewLine();					ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": (Rx) %7i %s   \t(Tx) %7i %s", static_cast<int>(rxData), kDataSizeUnits[rxUnitIdx], static_cast<int>(txData), kDataSizeUnits[txUnitIdx]);
+		ImGui::TextUnformatted("Comp.");	ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %5.1fx (Entropy) %4.2fx, Enc %i us, Dec %i us", Client.mStatsCompressionRatio, Client.mStatsEntropyRatio, static_cast<int>(Client.mStatsEntropyEncodeUs), static_cast<int>(Client.mStatsEntropyDecodeUs));
+		ImGui::TextUnformatted("Groups");	ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %i (New) %i (Removed) %i", static_cast<int>(Client.mStatsDrawGroups), static_cast<int>(Client.mStatsDrawGroupsNew), static_cast<int>(Client.mStatsDrawGroupsDel));
 		ImGui::EndTooltip();
 	}
 }
@@ -221,6 +223,7 @@ void Popup_ServerConfig()
 	static float sEditRefreshFPSActive		= 0;
 	static float sEditRefreshFPSInactive	= 0;
 	static bool sEditCompressionEnable		= true;
+	static bool sEditEntropyCompressionEnable	= false;
 	static float sSavedDPIScalePourcentage	= 0.f;
 	if( gPopup_ServerConfig_Show )
 	{		
@@ -229,6 +232,7 @@ void Popup_ServerConfig()
 			sEditRefreshFPSActive		= NetImguiServer::Config::Server::sRefreshFPSActive;
 			sEditRefreshFPSInactive		= NetImguiServer::Config::Server::sRefreshFPSInactive;
 			sEditCompressionEnable		= NetImguiServer::Config::Server::sCompressionEnable;
+			sEditEntropyCompressionEnable	= NetImguiServer::Config::Server::sEntropyCompressionEnable;
 			sSavedDPIScalePourcentage	= NetImguiServer::Config::Server::sDPIScaleRatio;
 		}
 		ImGuiWindowClass windowClass;
@@ -285,6 +289,12 @@ void Popup_ServerConfig()
 									"Greatly reduce bandwidth for a small CPU overhead on the client.\n"
 									"Note: This setting can be overridden on client side.");
 			}
+			ImGui::Checkbox("Use Entropy Compression", &sEditEntropyCompressionEnable);
+			if( ImGui::IsItemHovered() ){
+				ImGui::SetTooltip(	"Entropy code compressed data of large changes (scrolling or animated windows).\n"
+									"Further reduce bandwidth on slow connections, for some extra CPU usage.\n"
+									"Note: Only used when supported by both Client and Server, on connection.");
+			}
 
 			// --- Save/Cancel ---
 			ImGui::NewLine();
@@ -299,6 +309,7 @@ void Popup_ServerConfig()
 				NetImguiServer::Config::Server::sRefreshFPSActive	= sEditRefreshFPSActive;
 				NetImguiServer::Config::Server::sRefreshFPSInactive	= sEditRefreshFPSInactive;
 				NetImguiServer::Config::Server::sCompressionEnable	= sEditCompressionEnable;
+				NetImguiServer::Config::Server::sEntropyCompressionEnable	= sEditEntropyCompressionEnable;
 				NetImguiServer::Config::Client::SaveAll();
 				gPopup_ServerConfig_Show = false;
 			}